@@ -1,8 +1,45 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <numeric>
 
+// Number of points the batch kernels keep accumulators for at a time.
+constexpr int64_t DISTANCE_BATCH_SIZE = 256;
+
+// Accumulates term(query feature, point feature) over the features of count points stored feature-major, feature f of
+// point j at features[f * ld + j], and writes finish(sum) to out[j]. The inner loop runs across points, so it
+// vectorizes however few features there are. Sums are kept in double like the row kernels, so both give the same
+// distances.
+template <typename T, typename Iter, class Term, class Finish>
+void batchDistances(const Iter queryBegin, const Iter queryEnd, const T* const features, const int64_t ld,
+                    const int64_t count, T* const out, Term term, Finish finish)
+{
+    double acc[DISTANCE_BATCH_SIZE];
+    for (int64_t blockBegin = 0; blockBegin < count; blockBegin += DISTANCE_BATCH_SIZE)
+    {
+        auto blockSize = std::min(DISTANCE_BATCH_SIZE, count - blockBegin);
+        std::fill(acc, acc + blockSize, 0.0);
+
+        auto feature = features + blockBegin;
+        for (auto iter = queryBegin; iter != queryEnd; ++iter, feature += ld)
+        {
+            const T val = *iter;
+#pragma omp simd
+            for (int64_t j = 0; j < blockSize; ++j)
+            {
+                acc[j] += term(val, feature[j]);
+            }
+        }
+
+        for (int64_t j = 0; j < blockSize; ++j)
+        {
+            out[blockBegin + j] = finish(acc[j]);
+        }
+    }
+}
+
 template <typename T>
 struct L2Norm
 {
@@ -14,6 +51,20 @@ struct L2Norm
 
         return std::sqrt(result);
     }
+
+    // Distances from the query point to count points stored feature-major, see batchDistances.
+    template <typename Iter>
+    void batch(const Iter queryBegin, const Iter queryEnd, const T* const features, const int64_t ld,
+               const int64_t count, T* const out) const
+    {
+        batchDistances(
+          queryBegin, queryEnd, features, ld, count, out,
+          [](const T val1, const T val2) {
+              double diff = val1 - val2;
+              return diff * diff;
+          },
+          [](const double sum) { return static_cast<T>(std::sqrt(sum)); });
+    }
 };
 
 template <typename T>
@@ -25,4 +76,15 @@ struct L1Norm
         return std::inner_product(p1Begin, p1End, p2Begin, 0.0, std::plus<>(),
                                   [](const T val1, const T val2) { return std::abs(val1 - val2); });
     }
-};
\ No newline at end of file
+
+    // Distances from the query point to count points stored feature-major, see batchDistances.
+    template <typename Iter>
+    void batch(const Iter queryBegin, const Iter queryEnd, const T* const features, const int64_t ld,
+               const int64_t count, T* const out) const
+    {
+        batchDistances(
+          queryBegin, queryEnd, features, ld, count, out,
+          [](const T val1, const T val2) { return std::abs(val1 - val2); },
+          [](const double sum) { return static_cast<T>(sum); });
+    }
+};
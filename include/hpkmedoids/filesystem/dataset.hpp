@@ -0,0 +1,294 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <matrix/matrix.hpp>
+#include <matrix/matrix_view.hpp>
+#include <string>
+#include <vector>
+
+namespace hpkmedoids
+{
+enum class DType : uint32_t
+{
+    Float32 = 1,
+    Float64 = 2
+};
+
+template <typename T>
+constexpr DType dtypeOf();
+
+template <>
+constexpr DType dtypeOf<float>()
+{
+    return DType::Float32;
+}
+
+template <>
+constexpr DType dtypeOf<double>()
+{
+    return DType::Float64;
+}
+
+// Upper bound for the rows read or converted at once.
+constexpr int64_t DATASET_BLOCK_BYTES = 8 << 20;
+
+// Size of an element of dtype in bytes, 0 for unknown dtypes.
+int64_t dtypeSize(const DType dtype);
+
+// A dataset file starts with this header, in native byte order, followed by zeros up to payloadOffset(). The payload
+// holds rows rows of stride elements of dtype, of which the first cols are data and the rest zeros. payloadOffset()
+// is a multiple of alignment, which is itself a multiple of the page size by default, so the payload can be mapped
+// and used in place. If flags has HAS_CHECKSUM, checksum is datasetChecksum of the whole payload.
+struct DatasetHeader
+{
+    char magic[8];
+    uint32_t version;
+    DType dtype;
+    int64_t rows;
+    int64_t cols;
+    int64_t stride;
+    int64_t alignment;
+    uint64_t checksum;
+    uint32_t flags;
+    uint32_t reserved;
+
+    static constexpr char MAGIC[8]            = { 'H', 'P', 'K', 'M', 'D', 'A', 'T', 'A' };
+    static constexpr uint32_t VERSION         = 1;
+    static constexpr uint32_t HAS_CHECKSUM    = 1;
+    static constexpr int64_t DEFAULT_ALIGNMENT = 4096;
+
+    int64_t payloadOffset() const;
+
+    int64_t payloadBytes() const;
+
+    bool hasChecksum() const;
+};
+
+static_assert(sizeof(DatasetHeader) == 64, "The dataset header is 64 bytes in every build.");
+
+enum class HeaderStatus
+{
+    Dataset,
+    Raw,
+    Invalid
+};
+
+// Reads the header of filepath. Files that do not start with the magic, e.g. raw datasets, are Raw. Files that cannot
+// be opened, have a header this build cannot read or are shorter than their header says are Invalid, and why is
+// printed to std::cerr. Never exits, so that MPI callers can abort every rank instead.
+HeaderStatus checkDatasetHeader(const std::string& filepath, DatasetHeader* const header);
+
+// Returns false if filepath is not in the dataset format, e.g. a raw dataset. Exits on headers it cannot read.
+bool readDatasetHeader(const std::string& filepath, DatasetHeader* const header);
+
+// 64 bit FNV-1a of bytes, continuing from hash so that it can be computed piecewise.
+uint64_t datasetChecksum(const char* const bytes, const int64_t size, const uint64_t hash = 14695981039346656037ull);
+
+// Reads a dataset into a new matrix, converting the elements to T if the file holds another dtype, and verifies the
+// checksum if the file has one.
+template <typename T>
+class DatasetReader
+{
+public:
+    // With padRows the rows of the returned matrices are padded, see Matrix.
+    DatasetReader(const bool padRows = false) : m_padRows(padRows) {}
+
+    Matrix<T> read(const std::string& filepath);
+
+private:
+    template <typename Source>
+    static void convertRows(const char* const buffer, const DatasetHeader& header, const int64_t firstRow,
+                            const int64_t numRows, Matrix<T>* const data);
+
+private:
+    bool m_padRows;
+};
+
+// Writes matrices in the dataset format, either at once or as blocks of rows appended to an open file, so that
+// datasets larger than memory can be written.
+template <typename T>
+class DatasetWriter
+{
+public:
+    // padRows pads the rows in the file like a padded Matrix, so that the rows of a mapped payload are aligned.
+    DatasetWriter(const bool padRows = false, const bool checksum = true,
+                  const int64_t alignment = DatasetHeader::DEFAULT_ALIGNMENT) :
+        m_padRows(padRows), m_checksum(checksum), m_alignment(alignment), m_header(), m_hash(0)
+    {
+    }
+
+    // Same as open, append and finish.
+    void write(const MatrixView<T>& data, const std::string& filepath);
+
+    // Starts a dataset of cols columns at filepath, leaving room for the header.
+    void open(const std::string& filepath, const int64_t cols);
+
+    // Writes the rows of block after the rows written so far.
+    void append(const MatrixView<T>& block);
+
+    // Writes the header, which depends on every row, and closes the file.
+    void finish();
+
+private:
+    bool m_padRows;
+    bool m_checksum;
+    int64_t m_alignment;
+    std::ofstream m_file;
+    DatasetHeader m_header;
+    uint64_t m_hash;
+    std::vector<T> m_row;
+};
+
+template <typename T>
+Matrix<T> DatasetReader<T>::read(const std::string& filepath)
+{
+    DatasetHeader header;
+    if (!readDatasetHeader(filepath, &header))
+    {
+        std::cerr << "Not a dataset file: " << filepath << std::endl;
+        exit(1);
+    }
+
+    std::ifstream file(filepath, std::ios::in | std::ios::binary);
+    file.seekg(header.payloadOffset());
+
+    Matrix<T> data(header.rows, header.cols, true, 0.0, m_padRows);
+    auto rowBytes     = header.stride * dtypeSize(header.dtype);
+    auto rowsPerBlock = std::max<int64_t>(1, DATASET_BLOCK_BYTES / std::max<int64_t>(rowBytes, 1));
+    std::vector<char> buffer(rowsPerBlock * rowBytes);
+    uint64_t checksum = datasetChecksum(nullptr, 0);
+
+    for (int64_t firstRow = 0; firstRow < header.rows; firstRow += rowsPerBlock)
+    {
+        auto numRows = std::min(rowsPerBlock, header.rows - firstRow);
+        if (!file.read(buffer.data(), numRows * rowBytes))
+        {
+            std::cerr << "Dataset file is truncated: " << filepath << std::endl;
+            exit(1);
+        }
+
+        if (header.hasChecksum())
+            checksum = datasetChecksum(buffer.data(), numRows * rowBytes, checksum);
+        if (header.dtype == DType::Float32)
+            convertRows<float>(buffer.data(), header, firstRow, numRows, &data);
+        else
+            convertRows<double>(buffer.data(), header, firstRow, numRows, &data);
+    }
+
+    if (header.hasChecksum() && checksum != header.checksum)
+    {
+        std::cerr << "Checksum mismatch in dataset file: " << filepath << std::endl;
+        exit(1);
+    }
+
+    return data;
+}
+
+template <typename T>
+template <typename Source>
+void DatasetReader<T>::convertRows(const char* const buffer, const DatasetHeader& header, const int64_t firstRow,
+                                   const int64_t numRows, Matrix<T>* const data)
+{
+    auto source = reinterpret_cast<const Source*>(buffer);
+    for (int64_t i = 0; i < numRows; ++i)
+    {
+        std::copy(source + i * header.stride, source + i * header.stride + header.cols, data->rowBegin(firstRow + i));
+    }
+}
+
+template <typename T>
+void DatasetWriter<T>::write(const MatrixView<T>& data, const std::string& filepath)
+{
+    open(filepath, data.cols());
+    append(data);
+    finish();
+}
+
+template <typename T>
+void DatasetWriter<T>::open(const std::string& filepath, const int64_t cols)
+{
+    m_file.open(filepath, std::ios::out | std::ios::binary);
+    if (!m_file.is_open())
+    {
+        std::cerr << "Unable to open file: " << filepath << std::endl;
+        exit(1);
+    }
+
+    m_header = {};
+    std::copy(DatasetHeader::MAGIC, DatasetHeader::MAGIC + sizeof(m_header.magic), m_header.magic);
+    m_header.version   = DatasetHeader::VERSION;
+    m_header.dtype     = dtypeOf<T>();
+    m_header.rows      = 0;
+    m_header.cols      = cols;
+    m_header.stride    = m_padRows ? Matrix<T>::paddedCols(cols) : cols;
+    m_header.alignment = m_alignment;
+    m_header.flags     = m_checksum ? DatasetHeader::HAS_CHECKSUM : 0;
+    m_hash             = datasetChecksum(nullptr, 0);
+    m_row.assign(m_header.stride, 0);
+
+    std::vector<char> zeros(m_header.payloadOffset(), 0);
+    m_file.write(zeros.data(), zeros.size());
+}
+
+template <typename T>
+void DatasetWriter<T>::append(const MatrixView<T>& block)
+{
+    for (int64_t i = 0; i < block.rows(); ++i)
+    {
+        std::copy(block.crowBegin(i), block.crowEnd(i), m_row.begin());
+        auto bytes = reinterpret_cast<const char*>(m_row.data());
+        if (m_checksum)
+            m_hash = datasetChecksum(bytes, m_row.size() * sizeof(T), m_hash);
+        m_file.write(bytes, m_row.size() * sizeof(T));
+    }
+    m_header.rows += block.rows();
+}
+
+template <typename T>
+void DatasetWriter<T>::finish()
+{
+    m_header.checksum = m_checksum ? m_hash : 0;
+
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    m_file.close();
+}
+
+// Writes the raw dataset at rawPath, numData rows of numFeatures elements of T without a header, to datasetPath in
+// the dataset format. The rows are converted in blocks of DATASET_BLOCK_BYTES, so the dataset never has to fit in
+// memory.
+template <typename T>
+void convertRawDataset(const std::string& rawPath, const std::string& datasetPath, const int64_t numData,
+                       const int64_t numFeatures, DatasetWriter<T> writer = DatasetWriter<T>())
+{
+    std::ifstream file(rawPath, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        std::cerr << "Unable to open file: " << rawPath << std::endl;
+        exit(1);
+    }
+
+    auto rowBytes = numFeatures * static_cast<int64_t>(sizeof(T));
+    if (static_cast<int64_t>(file.tellg()) < numData * rowBytes)
+    {
+        std::cerr << "Raw dataset file is smaller than " << numData << " x " << numFeatures << " elements: "
+                  << rawPath << std::endl;
+        exit(1);
+    }
+    file.seekg(0);
+
+    auto rowsPerBlock = std::min(numData, std::max<int64_t>(1, DATASET_BLOCK_BYTES / std::max<int64_t>(rowBytes, 1)));
+    Matrix<T> block = Matrix<T>::uninitialized(rowsPerBlock, numFeatures);
+    writer.open(datasetPath, numFeatures);
+    for (int64_t firstRow = 0; firstRow < numData; firstRow += rowsPerBlock)
+    {
+        auto numRows = std::min(rowsPerBlock, numData - firstRow);
+        file.read(reinterpret_cast<char*>(block.data()), numRows * rowBytes);
+        writer.append(MatrixView<T>(block).rowRange(0, numRows));
+    }
+    writer.finish();
+}
+}  // namespace hpkmedoids
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <future>
+#include <hpkmedoids/filesystem/dataset.hpp>
+#include <hpkmedoids/types/parallelism.hpp>
+#include <iostream>
+#include <matrix/matrix.hpp>
+#include <matrix/matrix_view.hpp>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpkmedoids
+{
+// A run of consecutive rows of a file fetched with a single read, and the part [begin, end) of the sorted row
+// indices it serves.
+struct RowRange
+{
+    int64_t firstRow;
+    int64_t numRows;
+    int32_t begin;
+    int32_t end;
+};
+
+// Groups sorted row indices into ranges of at most maxRangeBytes, merging rows that are at most maxGapBytes apart so
+// that neighbouring rows cost one read instead of several. Duplicate indices share a range.
+std::vector<RowRange> coalesceRows(const std::vector<std::pair<int32_t, int32_t>>& sortedRows, const int64_t rowBytes,
+                                   const int64_t maxGapBytes, const int64_t maxRangeBytes);
+
+// The rows of a dataset that stays on disk. Samples are gathered with positioned reads of the sorted and coalesced
+// rows, and the whole dataset is streamed in blocks with the next block being read while the current one is
+// processed, so datasets larger than memory can be clustered with CLARA. Reads are thread safe.
+template <typename T>
+class DiskRows
+{
+public:
+    // A file in the dataset format. Files of another dtype are converted to T row by row as they are read, like
+    // DatasetReader does.
+    explicit DiskRows(const std::string& filepath);
+
+    // A raw file of rows x cols elements.
+    DiskRows(const std::string& filepath, const int64_t rows, const int64_t cols);
+
+    DiskRows(const DiskRows&) = delete;
+
+    DiskRows& operator=(const DiskRows&) = delete;
+
+    ~DiskRows() { close(m_fd); }
+
+    int64_t rows() const { return m_rows; }
+
+    int64_t cols() const { return m_cols; }
+
+    // Reads count rows starting at row first into the first count rows of out.
+    void read(const int64_t first, const int64_t count, Matrix<T>* const out) const;
+
+    // Reads the selected rows into the rows of out in the order of selections.
+    template <Parallelism Level>
+    std::enable_if_t<Level == Parallelism::Serial || Level == Parallelism::MPI> gather(
+      const std::vector<int32_t>& selections, Matrix<T>* const out) const
+    {
+        auto sortedRows = sortSelections(selections);
+        std::vector<char> buffer;
+        for (const auto& range : planReads(sortedRows))
+        {
+            readRange(range, sortedRows, &buffer, out);
+        }
+    }
+
+    // As above, with the ranges read concurrently to keep several requests in flight.
+    template <Parallelism Level>
+    std::enable_if_t<Level == Parallelism::OMP || Level == Parallelism::Hybrid> gather(
+      const std::vector<int32_t>& selections, Matrix<T>* const out) const
+    {
+        auto sortedRows = sortSelections(selections);
+        auto ranges     = planReads(sortedRows);
+#pragma omp parallel shared(ranges, sortedRows, out)
+        {
+            std::vector<char> buffer;
+#pragma omp for schedule(dynamic)
+            for (int32_t i = 0; i < static_cast<int32_t>(ranges.size()); ++i)
+            {
+                readRange(ranges[i], sortedRows, &buffer, out);
+            }
+        }
+    }
+
+    // Calls visit(firstRow, block) for consecutive blocks of at most blockRows rows covering the whole dataset. The
+    // blocks live in two buffers that alternate, so the next block is read while visit processes the current one.
+    template <class Visit>
+    void stream(Visit visit, const int64_t blockRows = 0) const;
+
+    // Rows streamed at once by default.
+    int64_t defaultBlockRows() const { return std::max<int64_t>(1, STREAM_BLOCK_BYTES / rowBytes()); }
+
+    static constexpr int64_t COALESCE_GAP_BYTES = 64 << 10;
+    static constexpr int64_t MAX_RANGE_BYTES    = 4 << 20;
+    static constexpr int64_t STREAM_BLOCK_BYTES = 64 << 20;
+
+private:
+    void open(const std::string& filepath);
+
+    int64_t rowBytes() const { return m_stride * dtypeSize(m_dtype); }
+
+    // Copies the first cols elements of a row of the file, converting them to T.
+    void copyRow(const char* const row, T* const out) const;
+
+    // Pairs of (row, position in selections) sorted by row.
+    static std::vector<std::pair<int32_t, int32_t>> sortSelections(const std::vector<int32_t>& selections);
+
+    std::vector<RowRange> planReads(const std::vector<std::pair<int32_t, int32_t>>& sortedRows) const
+    {
+        return coalesceRows(sortedRows, rowBytes(), COALESCE_GAP_BYTES, MAX_RANGE_BYTES);
+    }
+
+    void readRange(const RowRange& range, const std::vector<std::pair<int32_t, int32_t>>& sortedRows,
+                   std::vector<char>* const buffer, Matrix<T>* const out) const;
+
+    // Reads bytes bytes at offset bytes into the payload, exiting if the file ends early.
+    void readBytes(char* const buffer, const int64_t bytes, const int64_t offset) const;
+
+private:
+    std::string m_filepath;
+    int m_fd;
+    DType m_dtype;
+    int64_t m_offset;
+    int64_t m_rows;
+    int64_t m_cols;
+    int64_t m_stride;
+};
+
+template <typename T>
+DiskRows<T>::DiskRows(const std::string& filepath) : m_filepath(filepath), m_fd(-1)
+{
+    DatasetHeader header;
+    if (!readDatasetHeader(filepath, &header))
+    {
+        std::cerr << "Not a dataset file: " << filepath << std::endl;
+        exit(1);
+    }
+
+    m_dtype  = header.dtype;
+    m_offset = header.payloadOffset();
+    m_rows   = header.rows;
+    m_cols   = header.cols;
+    m_stride = header.stride;
+    open(filepath);
+}
+
+template <typename T>
+DiskRows<T>::DiskRows(const std::string& filepath, const int64_t rows, const int64_t cols) :
+    m_filepath(filepath), m_fd(-1), m_dtype(dtypeOf<T>()), m_offset(0), m_rows(rows), m_cols(cols), m_stride(cols)
+{
+    open(filepath);
+}
+
+template <typename T>
+void DiskRows<T>::open(const std::string& filepath)
+{
+    m_fd = ::open(filepath.c_str(), O_RDONLY);
+    if (m_fd == -1)
+    {
+        std::cerr << "Unable to open file: " << filepath << std::endl;
+        exit(1);
+    }
+
+    // Only sampled rows and large sequential blocks are read, so readahead around single rows is wasted.
+    posix_fadvise(m_fd, 0, 0, POSIX_FADV_RANDOM);
+}
+
+template <typename T>
+void DiskRows<T>::read(const int64_t first, const int64_t count, Matrix<T>* const out) const
+{
+    if (m_dtype == dtypeOf<T>() && out->ld() == m_stride)
+    {
+        readBytes(reinterpret_cast<char*>(out->data()), count * rowBytes(), first * rowBytes());
+        return;
+    }
+
+    std::vector<char> buffer(std::min(count, std::max<int64_t>(1, MAX_RANGE_BYTES / rowBytes())) * rowBytes());
+    auto blockRows = static_cast<int64_t>(buffer.size()) / rowBytes();
+    for (int64_t blockBegin = 0; blockBegin < count; blockBegin += blockRows)
+    {
+        auto numRows = std::min(blockRows, count - blockBegin);
+        readBytes(buffer.data(), numRows * rowBytes(), (first + blockBegin) * rowBytes());
+
+        for (int64_t i = 0; i < numRows; ++i)
+        {
+            copyRow(buffer.data() + i * rowBytes(), out->rowBegin(blockBegin + i));
+        }
+    }
+}
+
+template <typename T>
+template <class Visit>
+void DiskRows<T>::stream(Visit visit, const int64_t blockRows) const
+{
+    auto numRows = blockRows > 0 ? std::min(blockRows, m_rows) : std::min(defaultBlockRows(), m_rows);
+    if (numRows == 0)
+        return;
+
+    Matrix<T> blocks[2] = { Matrix<T>::uninitialized(numRows, m_cols, m_stride != m_cols),
+                            Matrix<T>::uninitialized(numRows, m_cols, m_stride != m_cols) };
+    auto pending = std::async(std::launch::async, [&]() { read(0, numRows, &blocks[0]); });
+    for (int64_t first = 0, current = 0; first < m_rows; first += numRows, current ^= 1)
+    {
+        pending.get();
+
+        auto next = first + numRows;
+        if (next < m_rows)
+        {
+            pending = std::async(std::launch::async, [&, next, current]() {
+                read(next, std::min(numRows, m_rows - next), &blocks[current ^ 1]);
+            });
+        }
+
+        visit(first, MatrixView<T>(blocks[current]).rowRange(0, std::min(numRows, m_rows - first)));
+    }
+}
+
+template <typename T>
+std::vector<std::pair<int32_t, int32_t>> DiskRows<T>::sortSelections(const std::vector<int32_t>& selections)
+{
+    std::vector<std::pair<int32_t, int32_t>> sortedRows(selections.size());
+    for (int32_t i = 0; i < static_cast<int32_t>(selections.size()); ++i)
+    {
+        sortedRows[i] = { selections[i], i };
+    }
+    std::sort(sortedRows.begin(), sortedRows.end());
+
+    return sortedRows;
+}
+
+template <typename T>
+void DiskRows<T>::readRange(const RowRange& range, const std::vector<std::pair<int32_t, int32_t>>& sortedRows,
+                            std::vector<char>* const buffer, Matrix<T>* const out) const
+{
+    buffer->resize(range.numRows * rowBytes());
+    readBytes(buffer->data(), range.numRows * rowBytes(), range.firstRow * rowBytes());
+
+    for (int32_t i = range.begin; i < range.end; ++i)
+    {
+        copyRow(buffer->data() + (sortedRows[i].first - range.firstRow) * rowBytes(),
+                out->rowBegin(sortedRows[i].second));
+    }
+}
+
+template <typename T>
+void DiskRows<T>::copyRow(const char* const row, T* const out) const
+{
+    if (m_dtype == DType::Float32)
+        std::copy_n(reinterpret_cast<const float*>(row), m_cols, out);
+    else
+        std::copy_n(reinterpret_cast<const double*>(row), m_cols, out);
+}
+
+template <typename T>
+void DiskRows<T>::readBytes(char* const buffer, const int64_t bytes, const int64_t offset) const
+{
+    int64_t done = 0;
+    while (done < bytes)
+    {
+        auto count = pread(m_fd, buffer + done, static_cast<size_t>(bytes - done), m_offset + offset + done);
+        if (count == -1 && errno == EINTR)
+            continue;
+        if (count <= 0)
+        {
+            std::cerr << "Unable to read " << bytes << " bytes at offset " << m_offset + offset
+                      << " from file: " << m_filepath << std::endl;
+            exit(1);
+        }
+        done += count;
+    }
+}
+}  // namespace hpkmedoids
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <hpkmedoids/filesystem/dataset.hpp>
+#include <iostream>
+#include <matrix/matrix.hpp>
+#include <matrix/matrix_view.hpp>
+#include <string>
+#include <vector>
+
+namespace hpkmedoids
+{
+// How mapped data is going to be consumed. PAM walks the whole dataset, CLARA only touches the rows it samples.
+enum class AccessPattern
+{
+    Sequential,
+    Random
+};
+
+// Maps a raw binary dataset into memory instead of reading it. The returned views are over a read-only mapping whose
+// pages are only loaded from the page cache when touched, so opening even a very large dataset is near instant and
+// processes on the same node share one copy of it. Mappings live as long as the reader, which must outlive the views
+// it returns. Rows are never padded.
+template <typename T>
+class MmapMatrixReader
+{
+public:
+    MmapMatrixReader(const AccessPattern access = AccessPattern::Sequential) : m_access(access) {}
+
+    MmapMatrixReader(const MmapMatrixReader&) = delete;
+
+    MmapMatrixReader& operator=(const MmapMatrixReader&) = delete;
+
+    ~MmapMatrixReader();
+
+    MatrixView<T> read(const std::string& filepath, const int32_t& numData, const int32_t& numFeatures);
+
+    // Maps the payload of a file in the dataset format, whose shape and row stride come from its header. The checksum
+    // is not verified since that would touch every page. Files of another dtype are read and converted instead, and
+    // the converted matrix is kept by the reader like a mapping.
+    MatrixView<T> readDataset(const std::string& filepath);
+
+protected:
+    // Maps rows of cols elements, ld elements apart, starting offset bytes into the file.
+    MatrixView<T> map(const std::string& filepath, const int64_t offset, const int64_t rows, const int64_t cols,
+                      const int64_t ld);
+
+private:
+    struct Mapping
+    {
+        void* addr;
+        size_t length;
+    };
+
+    AccessPattern m_access;
+    std::vector<Mapping> m_mappings;
+    std::vector<Matrix<T>> m_converted;
+};
+
+template <typename T>
+MmapMatrixReader<T>::~MmapMatrixReader()
+{
+    for (const auto& mapping : m_mappings)
+    {
+        munmap(mapping.addr, mapping.length);
+    }
+}
+
+template <typename T>
+MatrixView<T> MmapMatrixReader<T>::read(const std::string& filepath, const int32_t& numData, const int32_t& numFeatures)
+{
+    return map(filepath, 0, numData, numFeatures, numFeatures);
+}
+
+template <typename T>
+MatrixView<T> MmapMatrixReader<T>::readDataset(const std::string& filepath)
+{
+    DatasetHeader header;
+    if (!readDatasetHeader(filepath, &header))
+    {
+        std::cerr << "Not a dataset file: " << filepath << std::endl;
+        exit(1);
+    }
+
+    if (header.dtype != dtypeOf<T>())
+    {
+        m_converted.push_back(DatasetReader<T>().read(filepath));
+        return MatrixView<T>(m_converted.back());
+    }
+
+    return map(filepath, header.payloadOffset(), header.rows, header.cols, header.stride);
+}
+
+template <typename T>
+MatrixView<T> MmapMatrixReader<T>::map(const std::string& filepath, const int64_t offset, const int64_t rows,
+                                       const int64_t cols, const int64_t ld)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        std::cerr << "Unable to open file: " << filepath << std::endl;
+        exit(1);
+    }
+
+    struct stat status;
+    auto length = static_cast<size_t>(offset + rows * ld * static_cast<int64_t>(sizeof(T)));
+    if (fstat(fd, &status) == -1 || static_cast<size_t>(status.st_size) < length)
+    {
+        std::cerr << "File " << filepath << " is too small for " << rows << " x " << cols << " elements." << std::endl;
+        exit(1);
+    }
+
+    if (rows * cols == 0)
+    {
+        close(fd);
+        return MatrixView<T>(nullptr, rows, cols, ld);
+    }
+
+    void* addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+    {
+        std::cerr << "Unable to map file: " << filepath << std::endl;
+        exit(1);
+    }
+
+    madvise(addr, length, m_access == AccessPattern::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    m_mappings.push_back({ addr, length });
+
+    return MatrixView<T>(reinterpret_cast<const T*>(static_cast<const char*>(addr) + offset), rows, cols, ld);
+}
+}  // namespace hpkmedoids
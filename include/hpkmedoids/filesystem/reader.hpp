@@ -1,9 +1,17 @@
 #pragma once
 
+#include <mpi.h>
+
+#include <algorithm>
 #include <fstream>
+#include <hpkmedoids/filesystem/dataset.hpp>
+#include <hpkmedoids/utils/utils.hpp>
 #include <iostream>
+#include <limits>
 #include <matrix/matrix.hpp>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace hpkmedoids
 {
@@ -20,9 +28,69 @@ template <typename T>
 class MatrixReader : public IReader<T>
 {
 public:
+    // With padRows the rows of the returned matrices are padded, see Matrix.
+    MatrixReader(const bool padRows = false) : m_padRows(padRows) {}
+
     std::ifstream openFile(const std::string& filepath);
 
     Matrix<T> read(const std::string& filepath, const int32_t& numData, const int32_t& numFeatures) override;
+
+private:
+    bool m_padRows;
+};
+
+// Reads a raw binary dataset with MPI-IO. Every rank reads its own contiguous block of rows through a row-block file
+// view with a single collective MPI_File_read_at_all, so large inputs are loaded in parallel instead of by one rank.
+// Rows are split between ranks the same way DataDistributor splits them.
+template <typename T>
+class MPIMatrixReader : public IReader<T>
+{
+public:
+    MPIMatrixReader(const bool padRows = false, const int root = 0);
+
+    // Collective. Returns the whole dataset on the root rank and an empty matrix on the others, as the fit of the
+    // distributed k-medoids takes it.
+    Matrix<T> read(const std::string& filepath, const int32_t& numData, const int32_t& numFeatures) override;
+
+    // Collective. Returns the calling rank's block of rows, as fitSlices of the distributed k-medoids takes it. The
+    // blocks are never assembled on the root rank.
+    Matrix<T> readSlice(const std::string& filepath, const int32_t& numData, const int32_t& numFeatures);
+
+    // Collective. As read for a file in the dataset format, whose shape and row stride come from its header. Files of
+    // another dtype are converted like DatasetReader does. The checksum is not verified. Aborts every rank if the
+    // file is not a readable dataset.
+    Matrix<T> readDataset(const std::string& filepath);
+
+    // Collective. As readSlice for a file in the dataset format.
+    Matrix<T> readDatasetSlice(const std::string& filepath);
+
+    int rowCount() const { return m_rowCounts[m_rank]; }
+
+    int rowOffset() const { return m_rowDispls[m_rank]; }
+
+private:
+    // Reads the calling rank's block of numData rows of Source elements that start offset bytes into the file and are
+    // stride elements apart, converting them to T.
+    template <typename Source>
+    Matrix<T> readRows(const std::string& filepath, const MPI_Offset offset, const int32_t numData,
+                       const int32_t numFeatures, const int64_t stride);
+
+    // Assembles the blocks read by every rank on the root rank.
+    Matrix<T> gather(const Matrix<T>& localData, const int32_t numData) const;
+
+    void partition(const int32_t numData);
+
+    // A row of numFeatures elements spanning ld elements, so that padded rows are skipped over in memory.
+    template <typename Element = T>
+    MPI_Datatype createRowType(const int32_t numFeatures, const int64_t ld) const;
+
+private:
+    bool m_padRows;
+    int m_root;
+    int m_rank;
+    int m_size;
+    std::vector<int> m_rowCounts;
+    std::vector<int> m_rowDispls;
 };
 
 template <typename T>
@@ -43,10 +111,153 @@ Matrix<T> MatrixReader<T>::read(const std::string& filepath, const int32_t& numD
 {
     auto file = openFile(filepath);
 
-    Matrix<T> data(numData, numFeatures, true);
-    file.read(reinterpret_cast<char*>(data.data()), sizeof(T) * numData * numFeatures);
+    Matrix<T> data(numData, numFeatures, true, 0.0, m_padRows);
+    if (data.ld() == numFeatures)
+        file.read(reinterpret_cast<char*>(data.data()), sizeof(T) * numData * numFeatures);
+    else
+    {
+        for (int32_t i = 0; i < numData; ++i)
+        {
+            file.read(reinterpret_cast<char*>(data.at(i)), sizeof(T) * numFeatures);
+        }
+    }
     file.close();
 
     return data;
 }
+
+template <typename T>
+MPIMatrixReader<T>::MPIMatrixReader(const bool padRows, const int root) :
+    m_padRows(padRows), m_root(root), m_rank(-1), m_size(-1)
+{
+    MPI_Comm_rank(MPI_COMM_WORLD, &m_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &m_size);
+}
+
+template <typename T>
+Matrix<T> MPIMatrixReader<T>::read(const std::string& filepath, const int32_t& numData, const int32_t& numFeatures)
+{
+    return gather(readSlice(filepath, numData, numFeatures), numData);
+}
+
+template <typename T>
+Matrix<T> MPIMatrixReader<T>::readSlice(const std::string& filepath, const int32_t& numData,
+                                        const int32_t& numFeatures)
+{
+    return readRows<T>(filepath, 0, numData, numFeatures, numFeatures);
+}
+
+template <typename T>
+Matrix<T> MPIMatrixReader<T>::readDataset(const std::string& filepath)
+{
+    auto localData = readDatasetSlice(filepath);
+    return gather(localData, m_rowDispls.back() + m_rowCounts.back());
+}
+
+template <typename T>
+Matrix<T> MPIMatrixReader<T>::readDatasetSlice(const std::string& filepath)
+{
+    DatasetHeader header;
+    auto status = checkDatasetHeader(filepath, &header);
+    if (status != HeaderStatus::Dataset)
+    {
+        if (status == HeaderStatus::Raw)
+            std::cerr << "Not a dataset file: " << filepath << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    if (header.rows > std::numeric_limits<int32_t>::max())
+    {
+        std::cerr << "Dataset file has more rows than can be distributed: " << filepath << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    auto numData     = static_cast<int32_t>(header.rows);
+    auto numFeatures = static_cast<int32_t>(header.cols);
+    if (header.dtype == DType::Float32)
+        return readRows<float>(filepath, header.payloadOffset(), numData, numFeatures, header.stride);
+
+    return readRows<double>(filepath, header.payloadOffset(), numData, numFeatures, header.stride);
+}
+
+template <typename T>
+template <typename Source>
+Matrix<T> MPIMatrixReader<T>::readRows(const std::string& filepath, const MPI_Offset offset, const int32_t numData,
+                                       const int32_t numFeatures, const int64_t stride)
+{
+    partition(numData);
+
+    MPI_File file;
+    if (MPI_File_open(MPI_COMM_WORLD, filepath.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS)
+    {
+        std::cerr << "Unable to open file: " << filepath << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    auto fileRowType   = createRowType<Source>(numFeatures, stride);
+    MPI_Offset rowSize = static_cast<MPI_Offset>(stride) * sizeof(Source);
+    MPI_File_set_view(file, offset + rowOffset() * rowSize, matchMPIType<Source>(), fileRowType, "native",
+                      MPI_INFO_NULL);
+
+    Matrix<Source> localData(rowCount(), numFeatures, true, 0.0, m_padRows);
+    auto memRowType = createRowType<Source>(numFeatures, localData.ld());
+    MPI_File_read_at_all(file, 0, localData.data(), rowCount(), memRowType, MPI_STATUS_IGNORE);
+
+    MPI_Type_free(&memRowType);
+    MPI_Type_free(&fileRowType);
+    MPI_File_close(&file);
+
+    if constexpr (std::is_same_v<Source, T>)
+        return localData;
+    else
+    {
+        Matrix<T> converted(rowCount(), numFeatures, true, 0.0, m_padRows);
+        for (int32_t i = 0; i < rowCount(); ++i)
+        {
+            std::copy(localData.crowBegin(i), localData.crowEnd(i), converted.rowBegin(i));
+        }
+
+        return converted;
+    }
+}
+
+template <typename T>
+Matrix<T> MPIMatrixReader<T>::gather(const Matrix<T>& localData, const int32_t numData) const
+{
+    Matrix<T> data;
+    if (m_rank == m_root)
+        data = Matrix<T>(numData, localData.cols(), true, 0.0, m_padRows);
+
+    auto rowType = createRowType(static_cast<int32_t>(localData.cols()), localData.ld());
+    MPI_Gatherv(localData.data(), rowCount(), rowType, data.data(), m_rowCounts.data(), m_rowDispls.data(), rowType,
+                m_root, MPI_COMM_WORLD);
+    MPI_Type_free(&rowType);
+
+    return data;
+}
+
+template <typename T>
+void MPIMatrixReader<T>::partition(const int32_t numData)
+{
+    m_rowCounts.resize(m_size);
+    m_rowDispls.resize(m_size);
+
+    for (int i = 0; i < m_size; ++i)
+    {
+        m_rowCounts[i] = numData / m_size + (i < numData % m_size ? 1 : 0);
+        m_rowDispls[i] = i == 0 ? 0 : m_rowDispls[i - 1] + m_rowCounts[i - 1];
+    }
+}
+
+template <typename T>
+template <typename Element>
+MPI_Datatype MPIMatrixReader<T>::createRowType(const int32_t numFeatures, const int64_t ld) const
+{
+    MPI_Datatype row, rowType;
+    MPI_Type_contiguous(numFeatures, matchMPIType<Element>(), &row);
+    MPI_Type_create_resized(row, 0, ld * static_cast<MPI_Aint>(sizeof(Element)), &rowType);
+    MPI_Type_commit(&rowType);
+    MPI_Type_free(&row);
+    return rowType;
+}
 }  // namespace hpkmedoids
\ No newline at end of file
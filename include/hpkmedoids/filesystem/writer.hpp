@@ -121,7 +121,15 @@ template <typename T>
 void ClusterResultWriter<T>::writeClusters(const Matrix<T>* clusters, std::string& filepath)
 {
     auto file = this->openFile(this->m_fileRotator.getUniqueFileName(filepath, "clusters"), std::ios::binary);
-    file.write(clusters->serialize(), clusters->bytes());
+    if (clusters->ld() == clusters->cols())
+        file.write(clusters->serialize(), clusters->bytes());
+    else
+    {
+        for (int64_t i = 0; i < clusters->rows(); ++i)
+        {
+            file.write(reinterpret_cast<const char*>(clusters->at(i)), sizeof(T) * clusters->cols());
+        }
+    }
     file.close();
 }
 
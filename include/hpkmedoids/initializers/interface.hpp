@@ -1,7 +1,9 @@
 #pragma once
 
 #include <hpkmedoids/types/clusters.hpp>
+#include <hpkmedoids/types/data_view.hpp>
 #include <hpkmedoids/types/distance_matrix.hpp>
+#include <hpkmedoids/types/fit_workspace.hpp>
 #include <hpkmedoids/types/selected_set.hpp>
 #include <matrix/matrix.hpp>
 
@@ -13,7 +15,7 @@ class IInitializer
 public:
     virtual ~IInitializer() = default;
 
-    virtual void initialize(const Matrix<T>* const data, Clusters<T>* const clusters,
-                            const DistanceMatrix<T>* const distMat) const = 0;
+    virtual void initialize(const DataView<T>* const data, Clusters<T>* const clusters,
+                            const DistanceMatrix<T>* const distMat, ScratchBuffers<T>* const scratch) const = 0;
 };
 }  // namespace hpkmedoids
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <algorithm>
+#include <boost/iterator/counting_iterator.hpp>
 #include <hpkmedoids/initializers/interface.hpp>
 #include <hpkmedoids/utils/utils.hpp>
 #include <limits>
+#include <numeric>
 
 namespace hpkmedoids
 {
@@ -13,63 +15,79 @@ template <typename T, Parallelism Level>
 class PAMBuild : public IInitializer<T>
 {
 public:
-    void initialize(const Matrix<T>* const data, Clusters<T>* const clusters,
-                    const DistanceMatrix<T>* const distMat) const override
+    void initialize(const DataView<T>* const data, Clusters<T>* const clusters, const DistanceMatrix<T>* const distMat,
+                    ScratchBuffers<T>* const scratch) const override
     {
-        initializeFirstCentroid(data, clusters, distMat);
+        initializeFirstCentroid(data, clusters, distMat, &scratch->distanceSums);
 
-        Matrix<T> dissimilarityMat(data->rows(), data->rows(), true, std::numeric_limits<T>::min());
+        // Every update rewrites every row, so the matrix is never initialized separately.
+        auto dissimilarityMat = &scratch->buildDissimilarities;
+        dissimilarityMat->reshapeUninitialized(data->rows(), data->rows());
         while (clusters->size() != clusters->maxSize())
         {
-            updateDissimilarityMatrix(&dissimilarityMat, data, clusters, distMat);
-            auto candidateIdx = getCandidateIdxForLargestGain(&dissimilarityMat);
+            updateDissimilarityMatrix(dissimilarityMat, data, clusters, distMat);
+            auto candidateIdx = getCandidateIdxForLargestGain(dissimilarityMat);
             clusters->addCentroid(candidateIdx);
-            dissimilarityMat.fill(std::numeric_limits<T>::min());
         }
     }
 
 private:
-    void initializeFirstCentroid(const Matrix<T>* const data, Clusters<T>* const clusters,
-                                 const DistanceMatrix<T>* const distMat) const
+    void initializeFirstCentroid(const DataView<T>* const data, Clusters<T>* const clusters,
+                                 const DistanceMatrix<T>* const distMat, std::vector<T>* const distanceSums) const
     {
-        auto distanceSums = calculateDistanceSums(distMat);
-        auto minIdx = std::distance(distanceSums.begin(), std::min_element(distanceSums.begin(), distanceSums.end()));
+        calculateDistanceSums(distanceSums, distMat);
+        auto minIdx =
+          std::distance(distanceSums->begin(), std::min_element(distanceSums->begin(), distanceSums->end()));
         clusters->addCentroid(minIdx);
     }
 
+    // The matrix is rewritten a row, i.e. a point, at a time, so with OMP every row is reset and updated by the same
+    // thread under the same static schedule, and the first update is the first touch of the matrix.
     template <Parallelism _Level = Level>
     std::enable_if_t<_Level == Parallelism::Serial || _Level == Parallelism::MPI> updateDissimilarityMatrix(
-      Matrix<T>* const dissimilarityMat, const Matrix<T>* const data, Clusters<T>* const clusters,
+      Matrix<T>* const dissimilarityMat, const DataView<T>* const data, Clusters<T>* const clusters,
       const DistanceMatrix<T>* const distMat) const
     {
-        for (const auto& candidateIdx : clusters->unselected())
+        for (int32_t pointIdx = 0; pointIdx < static_cast<int32_t>(dissimilarityMat->rows()); ++pointIdx)
         {
-            updateDissimilarityMatrixImpl(candidateIdx, dissimilarityMat, data, clusters, distMat);
+            updateDissimilarityRow(pointIdx, clusters->unselected().cbegin(), clusters->unselected().cend(),
+                                   dissimilarityMat, clusters, distMat);
         }
     }
 
     template <Parallelism _Level = Level>
     std::enable_if_t<_Level == Parallelism::OMP || _Level == Parallelism::Hybrid> updateDissimilarityMatrix(
-      Matrix<T>* const dissimilarityMat, const Matrix<T>* const data, Clusters<T>* const clusters,
+      Matrix<T>* const dissimilarityMat, const DataView<T>* const data, Clusters<T>* const clusters,
       const DistanceMatrix<T>* const distMat) const
     {
+        // The candidates are the first numCandidates points, as they always have been with OMP.
+        boost::counting_iterator<int32_t> candidatesBegin(0);
+        boost::counting_iterator<int32_t> candidatesEnd(clusters->numCandidates());
+
 #pragma omp parallel for schedule(static)
-        for (int32_t candidateIdx = 0; candidateIdx < static_cast<int32_t>(clusters->numCandidates()); ++candidateIdx)
+        for (int32_t pointIdx = 0; pointIdx < static_cast<int32_t>(dissimilarityMat->rows()); ++pointIdx)
         {
-            updateDissimilarityMatrixImpl(candidateIdx, dissimilarityMat, data, clusters, distMat);
+            updateDissimilarityRow(pointIdx, candidatesBegin, candidatesEnd, dissimilarityMat, clusters, distMat);
         }
     }
 
-    void updateDissimilarityMatrixImpl(const int candidateIdx, Matrix<T>* const dissimilarityMat,
-                                       const Matrix<T>* const data, Clusters<T>* const clusters,
-                                       const DistanceMatrix<T>* const distMat) const
+    template <typename Iter>
+    void updateDissimilarityRow(const int32_t pointIdx, Iter candidatesBegin, Iter candidatesEnd,
+                                Matrix<T>* const dissimilarityMat, Clusters<T>* const clusters,
+                                const DistanceMatrix<T>* const distMat) const
     {
-        for (const auto& pointIdx : clusters->unselected())
+        std::fill(dissimilarityMat->rowBegin(pointIdx), dissimilarityMat->rowEnd(pointIdx),
+                  std::numeric_limits<T>::min());
+        if (clusters->isSelected(pointIdx))
+            return;
+
+        auto distToClosestCentroid = distMat->distanceToClosestCentroid(pointIdx);
+        for (auto candidate = candidatesBegin; candidate != candidatesEnd; ++candidate)
         {
+            auto candidateIdx = *candidate;
             if (candidateIdx != pointIdx)
             {
-                auto distToClosestCentroid = distMat->distanceToClosestCentroid(pointIdx);
-                auto candidatePointDist    = distMat->distanceToPoint(candidateIdx, pointIdx);
+                auto candidatePointDist = distMat->distanceToPoint(candidateIdx, pointIdx);
                 dissimilarityMat->at(pointIdx, candidateIdx) =
                   std::max(distToClosestCentroid - candidatePointDist, 0.0);
             }
@@ -77,33 +95,29 @@ private:
     }
 
     template <Parallelism _Level = Level>
-    std::enable_if_t<_Level == Parallelism::Serial || _Level == Parallelism::MPI, std::vector<T>> calculateDistanceSums(
-      const DistanceMatrix<T>* const distMat) const
+    std::enable_if_t<_Level == Parallelism::Serial || _Level == Parallelism::MPI> calculateDistanceSums(
+      std::vector<T>* const distanceSums, const DistanceMatrix<T>* const distMat) const
     {
-        std::vector<T> distanceSums(distMat->numPoints());
+        distanceSums->resize(distMat->numPoints());
         for (int i = 0; i < distMat->numPoints(); ++i)
         {
-            auto range      = distMat->getAllDistancesToPoints(i);
-            distanceSums[i] = std::accumulate(range.first, range.second, 0.0);
+            auto range         = distMat->getAllDistancesToPoints(i);
+            (*distanceSums)[i] = std::accumulate(range.first, range.second, 0.0);
         }
-
-        return distanceSums;
     }
 
     template <Parallelism _Level = Level>
-    std::enable_if_t<_Level == Parallelism::OMP || _Level == Parallelism::Hybrid, std::vector<T>> calculateDistanceSums(
-      const DistanceMatrix<T>* const distMat) const
+    std::enable_if_t<_Level == Parallelism::OMP || _Level == Parallelism::Hybrid> calculateDistanceSums(
+      std::vector<T>* const distanceSums, const DistanceMatrix<T>* const distMat) const
     {
-        std::vector<T> distanceSums(distMat->numPoints());
+        distanceSums->resize(distMat->numPoints());
 
-#pragma omp parallel for shared(distanceSums), schedule(static)
+#pragma omp parallel for schedule(static)
         for (int i = 0; i < distMat->numPoints(); ++i)
         {
-            auto range      = distMat->getAllDistancesToPoints(i);
-            distanceSums[i] = std::accumulate(range.first, range.second, 0.0);
+            auto range         = distMat->getAllDistancesToPoints(i);
+            (*distanceSums)[i] = std::accumulate(range.first, range.second, 0.0);
         }
-
-        return distanceSums;
     }
 
     int32_t getCandidateIdxForLargestGain(const Matrix<T>* const dissimilarityMat) const
@@ -11,8 +11,8 @@ template <typename T>
 class RandomInitializer : public IInitializer<T>
 {
 public:
-    void initialize(const Matrix<T>* const data, Clusters<T>* const clusters,
-                    const DistanceMatrix<T>* const distMat) const override
+    void initialize(const DataView<T>* const data, Clusters<T>* const clusters,
+                    const DistanceMatrix<T>* const distMat, ScratchBuffers<T>* const scratch) const override
     {
         auto selections = m_selector.select(clusters->maxSize(), data->rows());
         for (const auto& selection : selections)
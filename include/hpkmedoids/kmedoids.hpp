@@ -1,4 +1,5 @@
 #pragma once
 
 #include <hpkmedoids/kmedoids/clara.hpp>
+#include <hpkmedoids/kmedoids/distributed_kmedoids.hpp>
 #include <hpkmedoids/kmedoids/kmedoids.hpp>
\ No newline at end of file
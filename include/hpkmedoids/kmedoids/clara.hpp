@@ -24,10 +24,42 @@ public:
         return p_impl->fit(data, numClusters, numRepeats, numSamplingIters);
     }
 
+    // Shared memory only, since the distributed implementations move the data between ranks as a Matrix.
+    template <Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::Serial || _Level == Parallelism::OMP, const Clusters<T>* const> fit(
+      const MatrixView<T>& data, const int& numClusters, const int& numRepeats, const int numSamplingIters)
+    {
+        return p_impl->fit(data, numClusters, numRepeats, numSamplingIters);
+    }
+
+    // Shared memory only, see SharedMemoryCLARAKMedoids.
+    template <Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::Serial || _Level == Parallelism::OMP, const Clusters<T>* const> fit(
+      const DiskRows<T>* const data, const int& numClusters, const int& numRepeats, const int numSamplingIters)
+    {
+        return p_impl->fit(data, numClusters, numRepeats, numSamplingIters);
+    }
+
+    // Distributed only, see DistributedCLARAKMedoids.
+    template <Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::MPI || _Level == Parallelism::Hybrid, const Clusters<T>* const> fitSlices(
+      const Matrix<T>* const localData, const int64_t numRows, const int& numClusters, const int& numRepeats,
+      const int numSamplingIters)
+    {
+        return p_impl->fitSlices(localData, numRows, numClusters, numRepeats, numSamplingIters);
+    }
+
     const Clusters<T>* const getResults() { return p_impl->getResults(); }
 
     void reset() { p_impl->reset(); }
 
+    template <Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::MPI || _Level == Parallelism::Hybrid> setScheduling(
+      const Scheduling scheduling)
+    {
+        p_impl->setScheduling(scheduling);
+    }
+
 private:
     std::unique_ptr<impl_type> p_impl;
 };
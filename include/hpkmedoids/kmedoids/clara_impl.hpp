@@ -4,6 +4,9 @@
 
 #include <functional>
 #include <hpkmedoids/kmedoids/kmedoids.hpp>
+#include <hpkmedoids/types/scheduling.hpp>
+#include <hpkmedoids/utils/candidate_evaluator.hpp>
+#include <hpkmedoids/utils/data_distributor.hpp>
 #include <hpkmedoids/utils/sampler.hpp>
 
 namespace hpkmedoids
@@ -29,13 +32,50 @@ public:
 
     virtual void reset() override
     {
-        m_bestNonSampledClusters = Clusters<T>();
+        m_bestNonSampledClusters.clear();
         KMedoids<T, Level, DistanceFunc>::reset();
     }
 
+protected:
+    const Clusters<T>* const fitSample(const DataView<T>* const sampledData, const int& numClusters,
+                                       const int& numRepeats)
+    {
+        KMedoids<T, Level, DistanceFunc>::reset();
+        return KMedoids<T, Level, DistanceFunc>::fit(sampledData, numClusters, numRepeats);
+    }
+
+    // Evaluates the centroids of the last sample fit over the full data, abandoning the evaluation once they can no
+    // longer beat the current best. The centroids are taken over from the sample results and a new best is taken
+    // over from the candidate by swapping buffers, never by copying. The assignments of the winner are only computed
+    // in materializeBestAssignments().
+    bool evaluateSampleResults(const DataView<T>& data)
+    {
+        m_candidateClusters.swap(this->m_bestClusters);
+        m_candidateClusters.rebind(data);
+        if (!m_candidateClusters.template calculateErrorFromCentroids<Level, DistanceFunc>(
+              m_distanceFunc, m_bestNonSampledClusters.getError()))
+            return false;
+
+        m_bestNonSampledClusters.swap(m_candidateClusters);
+        return true;
+    }
+
+    // The sample size for numData points, which never exceeds numData.
+    int32_t sampleSize(const int32_t numData, const int32_t numClusters) const
+    {
+        return std::min(m_sampleSizeCalc(numData, numClusters), numData);
+    }
+
+    void materializeBestAssignments()
+    {
+        if (m_bestNonSampledClusters.getClustering()->empty() && !m_bestNonSampledClusters.getCentroids()->empty())
+            m_bestNonSampledClusters.template calculateAssignmentsFromCentroids<Level, DistanceFunc>(m_distanceFunc);
+    }
+
 protected:
     Sampler<T> m_sampler;
     Clusters<T> m_bestNonSampledClusters;
+    Clusters<T> m_candidateClusters;
     DistanceFunc m_distanceFunc;
     std::function<int32_t(const int32_t, const int32_t)> m_sampleSizeCalc;
 };
@@ -53,19 +93,82 @@ public:
     const Clusters<T>* const fit(const Matrix<T>* const data, const int& numClusters, const int& numRepeats,
                                  const int numSamplingIters) override
     {
-        auto sampleSize = this->m_sampleSizeCalc(data->rows(), numClusters);
+        return fit(MatrixView<T>(*data), numClusters, numRepeats, numSamplingIters);
+    }
+
+    const Clusters<T>* const fit(const MatrixView<T>& data, const int& numClusters, const int& numRepeats,
+                                 const int numSamplingIters)
+    {
+        auto sampleSize = this->sampleSize(data.rows(), numClusters);
 
+        DataView<T> sample(data, &m_selections);
         for (int i = 0; i < numSamplingIters; ++i)
         {
-            auto sampledData = this->m_sampler.template sample<Level>(sampleSize, data);
-            KMedoids<T, Level, DistanceFunc>::fit(&sampledData, numClusters, numRepeats);
-            Clusters<T> clusters(data, this->m_bestClusters.getCentroids());
-            clusters.template calculateAssignmentsFromCentroids<Level, DistanceFunc>(this->m_distanceFunc);
-            this->compareResults(clusters, this->m_bestNonSampledClusters);
+            this->m_sampler.select(sampleSize, data.rows(), m_selections);
+            this->fitSample(&sample, numClusters, numRepeats);
+            this->evaluateSampleResults(data);
+        }
+
+        this->materializeBestAssignments();
+        return this->getResults();
+    }
+
+    // Out of core CLARA for data that stays on disk. Only the sampled rows are read while fitting the samples, after
+    // which the centroids of all samples are evaluated together in a single pass over the data and the assignments
+    // of the best ones in a second, so the data is never held in memory as a whole. The results are not bound to
+    // any data.
+    const Clusters<T>* const fit(const DiskRows<T>* const data, const int& numClusters, const int& numRepeats,
+                                 const int numSamplingIters)
+    {
+        auto sampleSize = this->sampleSize(data->rows(), numClusters);
+
+        Matrix<T> sampledData(sampleSize, data->cols(), true);
+        DataView<T> sample(&sampledData);
+        m_candidates.resize(numSamplingIters);
+        for (int i = 0; i < numSamplingIters; ++i)
+        {
+            this->m_sampler.select(sampleSize, data->rows(), m_selections);
+            this->m_sampler.template gather<Level>(m_selections, data, &sampledData);
+            this->fitSample(&sample, numClusters, numRepeats);
+            m_candidates[i].swap(this->m_bestClusters);
+        }
+
+        std::vector<T> errors(numSamplingIters, 0.0);
+        data->stream([&](const int64_t, const MatrixView<T>& block) {
+            for (int i = 0; i < numSamplingIters; ++i)
+            {
+                m_candidates[i].rebind(DataView<T>(block));
+                m_candidates[i].template calculateErrorFromCentroids<Level, DistanceFunc>(
+                  this->m_distanceFunc, std::numeric_limits<T>::max());
+                errors[i] += m_candidates[i].getError();
+            }
+        });
+
+        auto& best = m_candidates[std::min_element(errors.begin(), errors.end()) - errors.begin()];
+        std::vector<int32_t> assignments(data->rows());
+        T error = 0.0;
+        data->stream([&](const int64_t firstRow, const MatrixView<T>& block) {
+            best.rebind(DataView<T>(block));
+            best.template calculateAssignmentsFromCentroids<Level, DistanceFunc>(this->m_distanceFunc);
+            std::copy(best.getClustering()->begin(), best.getClustering()->end(), assignments.begin() + firstRow);
+            error += best.getError();
+        });
+
+        Clusters<T> results(DataView<T>(), Matrix<T>(*best.getCentroids()), error, std::move(assignments));
+        this->m_bestNonSampledClusters.swap(results);
+
+        // The candidates are still bound to the last streamed block, which is gone. Clearing keeps their buffers.
+        for (auto& candidate : m_candidates)
+        {
+            candidate.clear();
         }
 
         return this->getResults();
     }
+
+private:
+    std::vector<int32_t> m_selections;
+    std::vector<Clusters<T>> m_candidates;
 };
 
 template <typename T, Parallelism Level, class DistanceFunc>
@@ -73,13 +176,14 @@ class DistributedCLARAKMedoids : public CLARAKMedoidsImpl<T, Level, DistanceFunc
 {
 public:
     DistributedCLARAKMedoids(const std::string& initializer, const std::string& maximizer,
-                             std::function<int32_t(const int32_t, const int32_t)> sampleSizeCalc) :
+                             std::function<int32_t(const int32_t, const int32_t)> sampleSizeCalc,
+                             const Scheduling scheduling = Scheduling::MasterWorker) :
         CLARAKMedoidsImpl<T, Level, DistanceFunc>(initializer, maximizer, sampleSizeCalc),
         m_rank(-1),
         m_size(-1),
-        m_blank(0),
         m_samplesIssued(0),
-        m_dtype(matchMPIType<T>())
+        m_dtype(matchMPIType<T>()),
+        m_scheduling(scheduling)
     {
         MPI_Comm_rank(MPI_COMM_WORLD, &m_rank);
         MPI_Comm_size(MPI_COMM_WORLD, &m_size);
@@ -88,20 +192,35 @@ public:
     const Clusters<T>* const fit(const Matrix<T>* const data, const int& numClusters, const int& numRepeats,
                                  const int numSamplingIters) override
     {
-        int numCols     = data->cols();
-        auto sampleSize = this->m_sampleSizeCalc(data->rows(), numClusters);
-
-        MPI_Bcast(&numCols, 1, MPI_INT, MASTER, MPI_COMM_WORLD);
+        auto sampleSize = this->sampleSize(data->rows(), numClusters);
         MPI_Bcast(&sampleSize, 1, MPI_INT, MASTER, MPI_COMM_WORLD);
 
-        if (m_rank == MASTER)
-            master(data, numClusters, sampleSize, numSamplingIters);
+        auto sourceData = data;
+        Matrix<T> localData;
+        if (m_scheduling == Scheduling::MasterWorker)
+            localData = m_distributor.scatter(data, MASTER);
         else
-            worker(numCols, numClusters, sampleSize);
+        {
+            sourceData = m_distributor.replicateShared(data, &m_residentData, MASTER);
+            if (m_scheduling == Scheduling::DataResident)
+                localData = m_distributor.localBlock(sourceData);
+        }
 
-        MPI_Barrier(MPI_COMM_WORLD);
+        return fitResident(sourceData, &localData, numClusters, sampleSize, numSamplingIters);
+    }
 
-        return this->getResults();
+    // Collective. As fit for data whose numRows rows are already split across the ranks, localData being the calling
+    // rank's block as MPIMatrixReader::readSlice reads it. The master-worker scheduling gathers the blocks on the
+    // master, which samples from them, the others assemble them on every node without passing through the master.
+    const Clusters<T>* const fitSlices(const Matrix<T>* const localData, const int64_t numRows, const int& numClusters,
+                                       const int& numRepeats, const int numSamplingIters)
+    {
+        auto sampleSize = this->sampleSize(static_cast<int32_t>(numRows), numClusters);
+        auto sourceData = m_scheduling == Scheduling::MasterWorker
+                            ? m_distributor.gatherSlices(localData, numRows, &m_residentData, MASTER)
+                            : m_distributor.replicateSlices(localData, numRows, &m_residentData);
+
+        return fitResident(sourceData, localData, numClusters, sampleSize, numSamplingIters);
     }
 
     void reset() override
@@ -110,93 +229,311 @@ public:
         CLARAKMedoidsImpl<T, Level, DistanceFunc>::reset();
     }
 
+    void setScheduling(const Scheduling scheduling) { m_scheduling = scheduling; }
+
 private:
-    void master(const Matrix<T>* const data, const int32_t numClusters, const int32_t sampleSize,
-                const int numSamplingIters)
+    // data is where the scheduling samples from: the master's copy with master-worker and a copy on every rank
+    // otherwise. localData is the calling rank's block of the data, which decentralized scheduling does not use.
+    const Clusters<T>* const fitResident(const Matrix<T>* const data, const Matrix<T>* const localData,
+                                         const int32_t numClusters, const int32_t sampleSize,
+                                         const int numSamplingIters)
+    {
+        if (m_scheduling == Scheduling::Decentralized)
+        {
+            decentralized(data, numClusters, sampleSize, numSamplingIters);
+            MPI_Barrier(MPI_COMM_WORLD);
+            return this->getResults();
+        }
+
+        auto numCols    = static_cast<int>(localData->cols());
+        auto candidates = this->pooledMatrix(numSamplingIters * numClusters, numCols);
+
+        if (m_rank == MASTER)
+            master(data, &candidates, numClusters, sampleSize, numSamplingIters);
+        else
+            worker(data, numCols, numClusters, sampleSize);
+
+        evaluateCandidates(data, localData, &candidates, numClusters);
+
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        return this->getResults();
+    }
+
+    // Buffer for one sample in flight between the master and a worker. Depending on the scheduling it carries either
+    // the sampled rows or only their indices.
+    struct WorkBuffer
     {
-        Matrix<T> centroidBuffer(numClusters, data->cols(), true);
+        Matrix<T> sampledData;
+        std::vector<int32_t> selections;
+        MPI_Request request;
 
-        while (m_samplesIssued < numSamplingIters)
+        WorkBuffer(const int32_t sampleSize, const int32_t numCols) :
+            sampledData(sampleSize, numCols, true), selections(sampleSize), request(MPI_REQUEST_NULL)
         {
-            MPI_Status status;
-            MPI_Recv(&m_blank, 1, MPI_INT, MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+        }
+    };
 
-            if (status.MPI_TAG == REQUEST_TAG)
-                allocateWork(data, sampleSize, status);
-            else if (status.MPI_TAG == COMPLETED_TAG)
+    // The master keeps up to PREFETCH_DEPTH samples queued at every worker with nonblocking sends, so a worker can
+    // start its next sample as soon as it has posted the results of the current one, and waits on the results of all
+    // workers at once.
+    void master(const Matrix<T>* const data, Matrix<T>* const candidates, const int32_t numClusters,
+                const int32_t sampleSize, const int numSamplingIters)
+    {
+        auto numWorkers = m_size - 1;
+        std::vector<WorkBuffer> workBuffers(numWorkers * PREFETCH_DEPTH, WorkBuffer(sampleSize, data->cols()));
+        std::vector<int> nextBuffer(numWorkers, 0);
+        std::vector<int> outstanding(numWorkers, 0);
+        std::vector<MPI_Request> resultRequests(numWorkers, MPI_REQUEST_NULL);
+        auto resultBuffers = this->pooledMatrix(numWorkers * numClusters, data->cols(), true);
+
+        for (int depth = 0; depth < PREFETCH_DEPTH; ++depth)
+        {
+            for (int worker = 0; worker < numWorkers && m_samplesIssued < numSamplingIters; ++worker)
             {
-                processResults(data, &centroidBuffer, status);
-                if (m_samplesIssued < numSamplingIters)
-                    allocateWork(data, sampleSize, status);
+                sendWork(data, &workBuffers[worker * PREFETCH_DEPTH + nextBuffer[worker]], worker + 1);
+                nextBuffer[worker] = (nextBuffer[worker] + 1) % PREFETCH_DEPTH;
+                ++outstanding[worker];
             }
         }
 
-        terminate(data, &centroidBuffer);
+        for (int worker = 0; worker < numWorkers; ++worker)
+        {
+            if (outstanding[worker] > 0)
+                receiveResults(&resultBuffers, numClusters, worker, &resultRequests[worker]);
+        }
+
+        for (int received = 0; received < m_samplesIssued;)
+        {
+            int worker;
+            MPI_Waitany(numWorkers, resultRequests.data(), &worker, MPI_STATUS_IGNORE);
+            std::copy(resultBuffers.crowBegin(worker * numClusters),
+                      resultBuffers.crowEnd((worker + 1) * numClusters - 1),
+                      candidates->rowBegin(candidates->numRows()));
+            candidates->resize(candidates->numRows() + numClusters);
+            --outstanding[worker];
+            ++received;
+
+            if (m_samplesIssued < numSamplingIters)
+            {
+                sendWork(data, &workBuffers[worker * PREFETCH_DEPTH + nextBuffer[worker]], worker + 1);
+                nextBuffer[worker] = (nextBuffer[worker] + 1) % PREFETCH_DEPTH;
+                ++outstanding[worker];
+            }
+
+            if (outstanding[worker] > 0)
+                receiveResults(&resultBuffers, numClusters, worker, &resultRequests[worker]);
+        }
+
+        terminate(&workBuffers);
     }
 
-    void terminate(const Matrix<T>* const data, Matrix<T>* const centroidBuffer)
+    void terminate(std::vector<WorkBuffer>* const workBuffers)
     {
         for (int i = 1; i < m_size; ++i)
         {
-            MPI_Status status;
-            MPI_Recv(&m_blank, 1, MPI_INT, MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-            if (status.MPI_TAG == COMPLETED_TAG)
-                processResults(data, centroidBuffer, status);
-            MPI_Send(&m_blank, 1, MPI_INT, status.MPI_SOURCE, TERMINATE_TAG, MPI_COMM_WORLD);
+            MPI_Send(nullptr, 0, MPI_INT, i, TERMINATE_TAG, MPI_COMM_WORLD);
+        }
+
+        for (auto& workBuffer : *workBuffers)
+        {
+            MPI_Wait(&workBuffer.request, MPI_STATUS_IGNORE);
         }
     }
 
-    void allocateWork(const Matrix<T>* const data, const int32_t sampleSize, const MPI_Status& status)
+    void sendWork(const Matrix<T>* const data, WorkBuffer* const workBuffer, const int dest)
     {
-        auto sampledData = this->m_sampler.template sample<Level>(sampleSize, data);
-        MPI_Send(&m_blank, 1, MPI_INT, status.MPI_SOURCE, REQUEST_TAG, MPI_COMM_WORLD);
-        MPI_Send(sampledData.data(), sampledData.size(), m_dtype, status.MPI_SOURCE, REQUEST_TAG, MPI_COMM_WORLD);
+        MPI_Wait(&workBuffer->request, MPI_STATUS_IGNORE);
+        this->m_sampler.select(workBuffer->selections.size(), data->rows(), workBuffer->selections);
+
+        if (m_scheduling == Scheduling::DataResident)
+            MPI_Isend(workBuffer->selections.data(), workBuffer->selections.size(), MPI_INT32_T, dest, WORK_TAG,
+                      MPI_COMM_WORLD, &workBuffer->request);
+        else
+        {
+            this->m_sampler.template gather<Level>(workBuffer->selections, data, &workBuffer->sampledData);
+            MPI_Isend(workBuffer->sampledData.data(), workBuffer->sampledData.size(), m_dtype, dest, WORK_TAG,
+                      MPI_COMM_WORLD, &workBuffer->request);
+        }
+
         ++m_samplesIssued;
     }
 
-    void processResults(const Matrix<T>* const data, Matrix<T>* const centroids, const MPI_Status& status)
+    void receiveResults(Matrix<T>* const resultBuffers, const int32_t numClusters, const int worker,
+                        MPI_Request* const request)
     {
-        MPI_Recv(centroids->data(), centroids->size(), m_dtype, status.MPI_SOURCE, status.MPI_TAG, MPI_COMM_WORLD,
-                 MPI_STATUS_IGNORE);
-        Clusters<T> clusters(data, centroids);
-        clusters.template calculateAssignmentsFromCentroids<Level, DistanceFunc>(this->m_distanceFunc);
-        this->compareResults(clusters, this->m_bestNonSampledClusters);
+        MPI_Irecv(resultBuffers->at(worker * numClusters), numClusters * resultBuffers->cols(), m_dtype, worker + 1,
+                  RESULT_TAG, MPI_COMM_WORLD, request);
     }
 
-    void worker(const int numCols, const int numClusters, const int sampleSize)
+    // Workers keep a receive posted for every buffer so the next sample arrives while the current one is being fit.
+    // The results are sent back in a single message, which doubles as the request for more work.
+    void worker(const Matrix<T>* const data, const int numCols, const int numClusters, const int sampleSize)
     {
-        Matrix<T> sampledData(sampleSize, numCols, true);
+        std::vector<WorkBuffer> workBuffers(PREFETCH_DEPTH, WorkBuffer(sampleSize, numCols));
+        auto resultBuffer = this->pooledMatrix(numClusters, numCols, true);
+        MPI_Request resultRequest = MPI_REQUEST_NULL;
 
-        MPI_Send(&m_blank, 1, MPI_INT, MASTER, REQUEST_TAG, MPI_COMM_WORLD);
+        for (auto& workBuffer : workBuffers)
+        {
+            receiveWork(&workBuffer);
+        }
 
-        while (true)
+        for (int current = 0;; current = (current + 1) % PREFETCH_DEPTH)
         {
+            auto& workBuffer = workBuffers[current];
             MPI_Status status;
-            MPI_Recv(&m_blank, 1, MPI_INT, MASTER, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+            MPI_Wait(&workBuffer.request, &status);
 
             if (status.MPI_TAG == TERMINATE_TAG)
                 break;
 
-            MPI_Recv(sampledData.data(), sampledData.size(), m_dtype, MASTER, REQUEST_TAG, MPI_COMM_WORLD,
-                     MPI_STATUS_IGNORE);
-            KMedoids<T, Level, DistanceFunc>::fit(&sampledData, numClusters, 1);
+            auto sample    = m_scheduling == Scheduling::DataResident ? DataView<T>(data, &workBuffer.selections)
+                                                                      : DataView<T>(&workBuffer.sampledData);
+            auto centroids = this->fitSample(&sample, numClusters, 1)->getCentroids();
 
-            auto centroids = this->m_bestClusters.getCentroids();
-            MPI_Send(&m_blank, 1, MPI_INT, MASTER, COMPLETED_TAG, MPI_COMM_WORLD);
-            MPI_Send(centroids->data(), centroids->size(), m_dtype, MASTER, COMPLETED_TAG, MPI_COMM_WORLD);
+            MPI_Wait(&resultRequest, MPI_STATUS_IGNORE);
+            std::copy(centroids->cbegin(), centroids->cend(), resultBuffer.begin());
+            MPI_Isend(resultBuffer.data(), resultBuffer.size(), m_dtype, MASTER, RESULT_TAG, MPI_COMM_WORLD,
+                      &resultRequest);
+            receiveWork(&workBuffer);
         }
+
+        for (auto& workBuffer : workBuffers)
+        {
+            if (workBuffer.request != MPI_REQUEST_NULL)
+                MPI_Cancel(&workBuffer.request);
+            MPI_Wait(&workBuffer.request, MPI_STATUS_IGNORE);
+        }
+        MPI_Wait(&resultRequest, MPI_STATUS_IGNORE);
+    }
+
+    void receiveWork(WorkBuffer* const workBuffer)
+    {
+        if (m_scheduling == Scheduling::DataResident)
+            MPI_Irecv(workBuffer->selections.data(), workBuffer->selections.size(), MPI_INT32_T, MASTER, MPI_ANY_TAG,
+                      MPI_COMM_WORLD, &workBuffer->request);
+        else
+            MPI_Irecv(workBuffer->sampledData.data(), workBuffer->sampledData.size(), m_dtype, MASTER, MPI_ANY_TAG,
+                      MPI_COMM_WORLD, &workBuffer->request);
+    }
+
+    // Every rank repeatedly claims the next sample number from a counter held by the master with MPI_Fetch_and_op,
+    // draws that sample from its own counter-based stream, fits it and evaluates it over its copy of the data. The
+    // samples drawn are therefore independent of which rank fits them. The global best is found with a single
+    // MPI_MINLOC reduction and its centroids are broadcast by the rank that found it.
+    void decentralized(const Matrix<T>* const data, const int32_t numClusters, const int32_t sampleSize,
+                       const int numSamplingIters)
+    {
+        int64_t seed = this->m_sampler.getSeed();
+        MPI_Bcast(&seed, 1, MPI_INT64_T, MASTER, MPI_COMM_WORLD);
+        this->m_sampler.setSeed(seed);
+
+        int* counter;
+        MPI_Win counterWin;
+        MPI_Win_allocate(m_rank == MASTER ? sizeof(int) : 0, sizeof(int), MPI_INFO_NULL, MPI_COMM_WORLD, &counter,
+                         &counterWin);
+        if (m_rank == MASTER)
+            *counter = 0;
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        std::vector<int32_t> selections;
+        DataView<T> sample(data, &selections);
+        for (int sampleIdx = claimSample(counterWin); sampleIdx < numSamplingIters;
+             sampleIdx = claimSample(counterWin))
+        {
+            this->m_sampler.select(sampleSize, data->rows(), m_samplesIssued + sampleIdx, selections);
+            this->fitSample(&sample, numClusters, 1);
+            this->evaluateSampleResults(data);
+        }
+
+        MPI_Win_free(&counterWin);
+        m_samplesIssued += numSamplingIters;
+
+        struct
+        {
+            T error;
+            int rank;
+        } best = { this->m_bestNonSampledClusters.getError(), m_rank };
+        MPI_Allreduce(MPI_IN_PLACE, &best, 1, matchMPIPairType<T>(), MPI_MINLOC, MPI_COMM_WORLD);
+
+        if (best.error == std::numeric_limits<T>::max())
+            return;
+
+        auto centroids = this->pooledMatrix(numClusters, data->cols(), true);
+        if (m_rank == best.rank)
+            centroids = *this->m_bestNonSampledClusters.getCentroids();
+        MPI_Bcast(centroids.data(), centroids.size(), m_dtype, best.rank, MPI_COMM_WORLD);
+
+        this->m_bestNonSampledClusters = Clusters<T>(data, std::move(centroids), best.error);
+        if (m_rank == MASTER)
+            this->materializeBestAssignments();
+    }
+
+    int claimSample(MPI_Win counterWin) const
+    {
+        int one = 1;
+        int sampleIdx;
+        MPI_Win_lock(MPI_LOCK_SHARED, MASTER, 0, counterWin);
+        MPI_Fetch_and_op(&one, &sampleIdx, MPI_INT, MASTER, 0, MPI_SUM, counterWin);
+        MPI_Win_unlock(MASTER, counterWin);
+        return sampleIdx;
+    }
+
+    // Collectively scores the candidates gathered by the master: every rank evaluates all of them over its own block
+    // of the data and the partial errors are summed across ranks. Since the errors are non-negative a rank may drop a
+    // candidate as soon as its partial error alone reaches the current best. The assignments are only gathered for
+    // the winner.
+    void evaluateCandidates(const Matrix<T>* const data, const Matrix<T>* const localData,
+                            Matrix<T>* const candidates, const int32_t numClusters)
+    {
+        int numCandidateRows = candidates->numRows();
+        T bound              = this->m_bestNonSampledClusters.getError();
+
+        MPI_Bcast(&numCandidateRows, 1, MPI_INT, MASTER, MPI_COMM_WORLD);
+        MPI_Bcast(&bound, 1, m_dtype, MASTER, MPI_COMM_WORLD);
+        candidates->resize(numCandidateRows);
+        MPI_Bcast(candidates->data(), candidates->size(), m_dtype, MASTER, MPI_COMM_WORLD);
+
+        if (candidates->empty())
+            return;
+
+        auto costs = m_evaluator.evaluate(localData, candidates, numClusters, bound);
+        MPI_Allreduce(MPI_IN_PLACE, costs.data(), costs.size(), m_dtype, MPI_SUM, MPI_COMM_WORLD);
+
+        auto bestIdx = std::distance(costs.begin(), std::min_element(costs.begin(), costs.end()));
+        if (costs[bestIdx] >= bound)
+            return;
+
+        auto centroids = this->pooledMatrix(numClusters, candidates->cols());
+        for (int32_t i = bestIdx * numClusters; i < (bestIdx + 1) * numClusters; ++i)
+        {
+            centroids.append(candidates->crowBegin(i), candidates->crowEnd(i));
+        }
+
+        Clusters<T> localClusters(localData, &centroids);
+        localClusters.template calculateAssignmentsFromCentroids<Level, DistanceFunc>(this->m_distanceFunc);
+        auto assignments = m_distributor.gather(*localClusters.getClustering(), MASTER);
+
+        if (m_rank == MASTER)
+            this->m_bestNonSampledClusters =
+              Clusters<T>(data, std::move(centroids), costs[bestIdx], std::move(assignments));
     }
 
 private:
-    const int MASTER        = 0;
-    const int REQUEST_TAG   = 1;
-    const int COMPLETED_TAG = 2;
-    const int TERMINATE_TAG = 3;
+    const int MASTER         = 0;
+    const int WORK_TAG       = 1;
+    const int RESULT_TAG     = 2;
+    const int TERMINATE_TAG  = 3;
+    const int PREFETCH_DEPTH = 2;
 
     int m_rank;
     int m_size;
-    int m_blank;
     int m_samplesIssued;
     MPI_Datatype m_dtype;
+    Scheduling m_scheduling;
+    Matrix<T> m_residentData;
+    DataDistributor<T> m_distributor;
+    CandidateEvaluator<T, Level, DistanceFunc> m_evaluator;
 };
 }  // namespace hpkmedoids
\ No newline at end of file
@@ -0,0 +1,443 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <hpkmedoids/distances.hpp>
+#include <hpkmedoids/initializers/initializers.hpp>
+#include <hpkmedoids/maximizers/maximizers.hpp>
+#include <hpkmedoids/types/clusters.hpp>
+#include <hpkmedoids/types/fit_workspace.hpp>
+#include <hpkmedoids/types/pam_execution.hpp>
+#include <hpkmedoids/utils/data_distributor.hpp>
+#include <hpkmedoids/utils/distance_calculator.hpp>
+#include <hpkmedoids/utils/uniform_selectors.hpp>
+#include <hpkmedoids/utils/utils.hpp>
+#include <iostream>
+#include <limits>
+#include <matrix/buffer_pool.hpp>
+#include <memory>
+#include <omp.h>
+#include <string>
+#include <vector>
+
+namespace hpkmedoids
+{
+// PAM with the points split across ranks. Every rank computes and keeps only the block of rows of the distance matrix
+// that belongs to its points, so both the O(N^2) work and memory are divided by the number of ranks. Each BUILD and
+// SWAP step computes the rank's partial gains for every candidate and combines them with one MPI_Allreduce, after
+// which all ranks pick the same medoid. The results, including the assignments, are complete on the master only.
+//
+// With PAMExecution::ParallelRestarts the restarts are spread over the ranks instead, each rank running whole restarts
+// on its own full distance matrix, and the best result is selected with an MPI_MINLOC reduction. Random restarts draw
+// their initial medoids from a counter-based stream per restart, so the result does not depend on the rank count.
+template <typename T, Parallelism Level = Parallelism::MPI, class DistanceFunc = L1Norm<T>>
+class DistributedKMedoids
+{
+public:
+    DistributedKMedoids(const std::string& initializer, const std::string& maximizer,
+                        const PAMExecution execution = PAMExecution::PartitionedMatrix) :
+        m_rank(-1),
+        m_size(-1),
+        m_restartsIssued(0),
+        m_randomInit(initializer == RANDOM_INIT),
+        m_dtype(matchMPIType<T>()),
+        m_execution(execution),
+        p_initializer(createInitializer<T, Level>(initializer)),
+        p_maximizer(createMaximizer<T, Level>(maximizer))
+    {
+        if (maximizer != PAM)
+        {
+            std::cerr << "DistributedKMedoids only supports the " << PAM << " maximizer!\n";
+            exit(1);
+        }
+
+        MPI_Comm_rank(MPI_COMM_WORLD, &m_rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &m_size);
+    }
+
+    virtual ~DistributedKMedoids() = default;
+
+    // Collective. data only needs to be resident on the master.
+    const Clusters<T>* const fit(const Matrix<T>* const data, const int& numClusters, const int& numRepeats)
+    {
+        auto sourceData = m_distributor.replicateShared(data, &m_residentData, MASTER);
+        auto localData  = m_distributor.localBlock(sourceData);
+        return fitResident(sourceData, &localData, numClusters, numRepeats);
+    }
+
+    // Collective. As fit for data whose numRows rows are already split across the ranks, localData being the calling
+    // rank's block as MPIMatrixReader::readSlice reads it. The blocks are assembled on every node without passing
+    // through the master.
+    const Clusters<T>* const fitSlices(const Matrix<T>* const localData, const int64_t numRows, const int& numClusters,
+                                       const int& numRepeats)
+    {
+        auto sourceData = m_distributor.replicateSlices(localData, numRows, &m_residentData);
+        return fitResident(sourceData, localData, numClusters, numRepeats);
+    }
+
+    const Clusters<T>* const getResults() const { return &m_bestClusters; }
+
+    virtual void reset() { m_bestClusters.clear(); }
+
+    void setExecution(const PAMExecution execution) { m_execution = execution; }
+
+private:
+    // data is resident on every rank and localData is the calling rank's block of it.
+    const Clusters<T>* const fitResident(const Matrix<T>* const data, const Matrix<T>* const localData,
+                                         const int numClusters, const int numRepeats)
+    {
+        int64_t seed = m_selector.getSeed();
+        MPI_Bcast(&seed, 1, MPI_INT64_T, MASTER, MPI_COMM_WORLD);
+        m_selector.setSeed(seed);
+
+        if (m_execution == PAMExecution::ParallelRestarts)
+            parallelRestarts(data, numClusters, numRepeats);
+        else
+            partitionedMatrix(data, localData, numClusters, numRepeats);
+
+        m_restartsIssued += numRepeats;
+        return getResults();
+    }
+
+    void partitionedMatrix(const Matrix<T>* const data, const Matrix<T>* const localData, const int numClusters,
+                           const int numRepeats)
+    {
+        m_distanceCalc.calculateDistanceMatrix(localData, data, &m_localDistMat, &m_workspace.scratch.features);
+
+        for (int restartIdx = 0; restartIdx < numRepeats; ++restartIdx)
+        {
+            if (m_randomInit)
+                randomInit(numClusters, restartIdx);
+            else
+                build(numClusters);
+
+            swap();
+            compareResults(data);
+        }
+    }
+
+    void parallelRestarts(const Matrix<T>* const data, const int numClusters, const int numRepeats)
+    {
+        struct
+        {
+            T error;
+            int rank;
+        } best = { std::numeric_limits<T>::max(), m_rank };
+        std::vector<int32_t> medoids(numClusters);
+
+        if (m_rank < numRepeats)
+        {
+            DataView<T> view(data);
+            auto distMat  = &m_workspace.distMat;
+            auto clusters = &m_workspace.clusters;
+            distMat->template compute<Level, DistanceFunc>(data, numClusters);
+            for (int restartIdx = m_rank; restartIdx < numRepeats; restartIdx += m_size)
+            {
+                clusters->reset(view, distMat);
+                if (m_randomInit)
+                {
+                    for (const auto& selection : drawMedoids(numClusters, data->rows(), restartIdx))
+                    {
+                        clusters->addCentroid(selection);
+                    }
+                }
+                else
+                    p_initializer->initialize(&view, clusters, distMat, &m_workspace.scratch);
+
+                p_maximizer->maximize(&view, clusters, distMat, &m_workspace.scratch);
+                if (clusters->getError() < best.error)
+                {
+                    best.error = clusters->getError();
+                    std::copy(clusters->selected().cbegin(), clusters->selected().cend(), medoids.begin());
+                }
+            }
+        }
+
+        MPI_Allreduce(MPI_IN_PLACE, &best, 1, matchMPIPairType<T>(), MPI_MINLOC, MPI_COMM_WORLD);
+        if (best.error == std::numeric_limits<T>::max() || best.error >= m_bestClusters.getError())
+            return;
+
+        MPI_Bcast(medoids.data(), numClusters, MPI_INT32_T, best.rank, MPI_COMM_WORLD);
+
+        auto centroids = pooledMatrix(numClusters, data->cols());
+        for (const auto& medoid : medoids)
+        {
+            centroids.append(data->crowBegin(medoid), data->crowEnd(medoid));
+        }
+
+        std::vector<int32_t> assignments;
+        if (m_rank == MASTER)
+        {
+            Clusters<T> clusters(data, &centroids);
+            clusters.template calculateAssignmentsFromCentroids<Level>(m_distanceFunc);
+            assignments = *clusters.getClustering();
+        }
+
+        m_bestClusters = Clusters<T>(data, std::move(centroids), best.error, std::move(assignments));
+    }
+
+    std::vector<int32_t> drawMedoids(const int numClusters, const int32_t numPoints, const int restartIdx) const
+    {
+        return m_selector.select(numClusters, numPoints, m_restartsIssued + restartIdx);
+    }
+
+    void randomInit(const int numClusters, const int restartIdx)
+    {
+        auto selections = drawMedoids(numClusters, numPoints(), restartIdx);
+        m_medoids.assign(selections.cbegin(), selections.cend());
+        m_isMedoid.assign(numPoints(), false);
+        for (const auto& medoid : m_medoids)
+        {
+            m_isMedoid[medoid] = true;
+        }
+
+        m_nearest.resize(m_localDistMat.rows());
+        m_second.resize(m_localDistMat.rows());
+        m_nearestIdx.resize(m_localDistMat.rows());
+        updateNearest();
+    }
+
+    void build(const int numClusters)
+    {
+        m_medoids.clear();
+        m_isMedoid.assign(numPoints(), false);
+        m_nearest.assign(m_localDistMat.rows(), std::numeric_limits<T>::max());
+        m_second.assign(m_localDistMat.rows(), std::numeric_limits<T>::max());
+        m_nearestIdx.assign(m_localDistMat.rows(), -1);
+
+        std::vector<T> gains(numPoints());
+        while (static_cast<int>(m_medoids.size()) < numClusters)
+        {
+            calculateBuildGains(gains);
+            MPI_Allreduce(MPI_IN_PLACE, gains.data(), numPoints(), m_dtype, MPI_SUM, MPI_COMM_WORLD);
+
+            // the first medoid minimises the total distance, every later one maximises the reduction in cost
+            int32_t bestIdx = -1;
+            for (int32_t j = 0; j < numPoints(); ++j)
+            {
+                if (!m_isMedoid[j] && (bestIdx == -1 || (m_medoids.empty() ? gains[j] < gains[bestIdx]
+                                                                            : gains[j] > gains[bestIdx])))
+                    bestIdx = j;
+            }
+
+            m_medoids.push_back(bestIdx);
+            m_isMedoid[bestIdx] = true;
+            updateNearest();
+        }
+    }
+
+    void swap()
+    {
+        auto numClusters = static_cast<int32_t>(m_medoids.size());
+        auto tolerance   = -0.01 * (calculateError() / numPoints());
+
+        std::vector<T> deltas(numClusters * numPoints());
+        m_corrections.resize(std::max<size_t>(m_corrections.size(), omp_get_max_threads()));
+        while (true)
+        {
+            calculateSwapDeltas(deltas);
+            MPI_Allreduce(MPI_IN_PLACE, deltas.data(), static_cast<int>(deltas.size()), m_dtype, MPI_SUM,
+                          MPI_COMM_WORLD);
+
+            int64_t bestIdx = -1;
+            for (int64_t i = 0; i < static_cast<int64_t>(deltas.size()); ++i)
+            {
+                if (!m_isMedoid[i % numPoints()] && (bestIdx == -1 || deltas[i] < deltas[bestIdx]))
+                    bestIdx = i;
+            }
+
+            if (bestIdx == -1 || deltas[bestIdx] >= tolerance)
+                break;
+
+            auto centroidIdx = static_cast<int32_t>(bestIdx / numPoints());
+            auto candidate   = static_cast<int32_t>(bestIdx % numPoints());
+
+            m_isMedoid[m_medoids[centroidIdx]] = false;
+            m_medoids[centroidIdx]             = candidate;
+            m_isMedoid[candidate]              = true;
+            updateNearest();
+        }
+    }
+
+    template <Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::Serial || _Level == Parallelism::MPI> calculateBuildGains(
+      std::vector<T>& gains) const
+    {
+        for (int32_t candidate = 0; candidate < numPoints(); ++candidate)
+        {
+            gains[candidate] = calculateBuildGain(candidate);
+        }
+    }
+
+    template <Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::OMP || _Level == Parallelism::Hybrid> calculateBuildGains(
+      std::vector<T>& gains) const
+    {
+#pragma omp parallel for schedule(static)
+        for (int32_t candidate = 0; candidate < numPoints(); ++candidate)
+        {
+            gains[candidate] = calculateBuildGain(candidate);
+        }
+    }
+
+    // Partial gain of the local points if candidate became a medoid, or its total distance to them when there are no
+    // medoids yet.
+    T calculateBuildGain(const int32_t candidate) const
+    {
+        T gain = 0.0;
+        for (int32_t i = 0; i < m_localDistMat.rows(); ++i)
+        {
+            auto pointIdx = m_distributor.rowOffset() + i;
+            if (m_medoids.empty())
+                gain += m_localDistMat.at(i, candidate);
+            else if (!m_isMedoid[pointIdx] && pointIdx != candidate)
+                gain += std::max(m_nearest[i] - m_localDistMat.at(i, candidate), static_cast<T>(0.0));
+        }
+
+        return gain;
+    }
+
+    template <Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::Serial || _Level == Parallelism::MPI> calculateSwapDeltas(
+      std::vector<T>& deltas)
+    {
+        for (int32_t candidate = 0; candidate < numPoints(); ++candidate)
+        {
+            calculateSwapDelta(candidate, deltas, &m_corrections[0]);
+        }
+    }
+
+    template <Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::OMP || _Level == Parallelism::Hybrid> calculateSwapDeltas(
+      std::vector<T>& deltas)
+    {
+#pragma omp parallel
+        {
+            auto correction = &m_corrections[omp_get_thread_num()];
+#pragma omp for schedule(static)
+            for (int32_t candidate = 0; candidate < numPoints(); ++candidate)
+            {
+                calculateSwapDelta(candidate, deltas, correction);
+            }
+        }
+    }
+
+    // Partial change in cost of the local points for swapping every medoid with candidate. A point only assigned to
+    // the removed medoid falls back to its second closest medoid, every other point keeps its medoid unless the
+    // candidate is closer, so the common term is accumulated once and corrected for the point's own medoid.
+    // correction is the calling thread's scratch buffer for the corrections.
+    void calculateSwapDelta(const int32_t candidate, std::vector<T>& deltas, std::vector<T>* const correction) const
+    {
+        auto numClusters = static_cast<int32_t>(m_medoids.size());
+        T common         = 0.0;
+        correction->assign(numClusters, 0.0);
+
+        for (int32_t i = 0; i < m_localDistMat.rows(); ++i)
+        {
+            auto pointIdx = m_distributor.rowOffset() + i;
+            if (m_isMedoid[pointIdx] || pointIdx == candidate)
+                continue;
+
+            auto candidateDist = m_localDistMat.at(i, candidate);
+            auto kept          = std::min(candidateDist - m_nearest[i], static_cast<T>(0.0));
+            common += kept;
+            (*correction)[m_nearestIdx[i]] += std::min(candidateDist, m_second[i]) - m_nearest[i] - kept;
+        }
+
+        for (int32_t centroidIdx = 0; centroidIdx < numClusters; ++centroidIdx)
+        {
+            deltas[centroidIdx * numPoints() + candidate] = common + (*correction)[centroidIdx];
+        }
+    }
+
+    void updateNearest()
+    {
+        for (int32_t i = 0; i < m_localDistMat.rows(); ++i)
+        {
+            m_nearest[i]    = std::numeric_limits<T>::max();
+            m_second[i]     = std::numeric_limits<T>::max();
+            m_nearestIdx[i] = -1;
+
+            for (int32_t centroidIdx = 0; centroidIdx < static_cast<int32_t>(m_medoids.size()); ++centroidIdx)
+            {
+                auto dist = m_localDistMat.at(i, m_medoids[centroidIdx]);
+                if (dist < m_nearest[i])
+                {
+                    m_second[i]     = m_nearest[i];
+                    m_nearest[i]    = dist;
+                    m_nearestIdx[i] = centroidIdx;
+                }
+                else if (dist < m_second[i])
+                    m_second[i] = dist;
+            }
+        }
+    }
+
+    T calculateError() const
+    {
+        T error = 0.0;
+        for (const auto& dist : m_nearest)
+        {
+            error += std::pow(dist, 2);
+        }
+
+        MPI_Allreduce(MPI_IN_PLACE, &error, 1, m_dtype, MPI_SUM, MPI_COMM_WORLD);
+        return error;
+    }
+
+    void compareResults(const Matrix<T>* const data)
+    {
+        auto error       = calculateError();
+        auto assignments = m_distributor.gather(m_nearestIdx, MASTER);
+        if (error >= m_bestClusters.getError())
+            return;
+
+        auto centroids = pooledMatrix(m_medoids.size(), data->cols());
+        for (const auto& medoid : m_medoids)
+        {
+            centroids.append(data->crowBegin(medoid), data->crowEnd(medoid));
+        }
+
+        m_bestClusters = Clusters<T>(data, std::move(centroids), error, std::move(assignments));
+    }
+
+    int32_t numPoints() const { return static_cast<int32_t>(m_localDistMat.cols()); }
+
+    // As in KMedoids, for the centroids built anew in every fit.
+    Matrix<T> pooledMatrix(const int64_t rows, const int64_t cols)
+    {
+        Matrix<T> matrix(&m_pool);
+        matrix.reshape(rows, cols);
+        return matrix;
+    }
+
+private:
+    const int MASTER = 0;
+
+    int m_rank;
+    int m_size;
+    int64_t m_restartsIssued;
+    bool m_randomInit;
+    MPI_Datatype m_dtype;
+    PAMExecution m_execution;
+    BufferPool m_pool;
+    Matrix<T> m_residentData;
+    Matrix<T> m_localDistMat;
+    std::vector<int32_t> m_medoids;
+    std::vector<bool> m_isMedoid;
+    std::vector<T> m_nearest;
+    std::vector<T> m_second;
+    std::vector<int32_t> m_nearestIdx;
+    std::vector<std::vector<T>> m_corrections;
+    Clusters<T> m_bestClusters;
+    FitWorkspace<T> m_workspace;
+    DataDistributor<T> m_distributor;
+    DistanceCalculator<T, Level, DistanceFunc> m_distanceCalc;
+    DistanceFunc m_distanceFunc;
+    UniformSelector m_selector;
+    std::unique_ptr<IInitializer<T>> p_initializer;
+    std::unique_ptr<IMaximizer<T>> p_maximizer;
+};
+}  // namespace hpkmedoids
@@ -3,6 +3,8 @@
 #include <hpkmedoids/distances.hpp>
 #include <hpkmedoids/initializers/initializers.hpp>
 #include <hpkmedoids/maximizers/maximizers.hpp>
+#include <hpkmedoids/types/fit_workspace.hpp>
+#include <matrix/buffer_pool.hpp>
 #include <string>
 
 namespace hpkmedoids
@@ -20,14 +22,38 @@ public:
 
     const Clusters<T>* const fit(const Matrix<T>* const data, const int& numClusters, const int& numRepeats)
     {
-        auto distMat = DistanceMatrix<T>::template create<Level, DistanceFunc>(data, numClusters);
+        DataView<T> view(data);
+        return fit(&view, numClusters, numRepeats);
+    }
+
+    // Fits data held in memory the caller owns without copying it, e.g. a block of rows or columns of a larger matrix.
+    const Clusters<T>* const fit(const MatrixView<T>& data, const int& numClusters, const int& numRepeats)
+    {
+        DataView<T> view(data);
+        return fit(&view, numClusters, numRepeats);
+    }
 
+    // Fits the rows of the view in place, e.g. a sample given as indices into the full data.
+    const Clusters<T>* const fit(const DataView<T>* const data, const int& numClusters, const int& numRepeats)
+    {
+        auto distMat  = &m_workspace.distMat;
+        auto clusters = &m_workspace.clusters;
+        distMat->template compute<Level, DistanceFunc>(data, numClusters);
+
+        bool improved = false;
         for (int i = 0; i < numRepeats; ++i)
         {
-            Clusters<T> clusters(data, &distMat);
-            p_initializer->initialize(data, &clusters, &distMat);
-            p_maximizer->maximize(data, &clusters, &distMat);
-            compareResults(clusters, m_bestClusters);
+            clusters->reset(*data, distMat);
+            p_initializer->initialize(data, clusters, distMat, &m_workspace.scratch);
+            p_maximizer->maximize(data, clusters, distMat, &m_workspace.scratch);
+            improved |= compareResults(*clusters, m_bestClusters);
+        }
+
+        // The repeats only track errors, the assignments are computed once for the winner.
+        if (improved)
+        {
+            m_bestClusters.restoreCentroidDistances();
+            m_bestClusters.template calculateAssignmentsFromDistMat<Level>();
         }
 
         return getResults();
@@ -35,19 +61,35 @@ public:
 
     const Clusters<T>* const getResults() const { return &m_bestClusters; }
 
-    virtual void reset() { m_bestClusters = Clusters<T>(); }
+    virtual void reset() { m_bestClusters.clear(); }
 
 protected:
-    void compareResults(const Clusters<T>& candidateClusters, Clusters<T>& bestClusters)
+    // The candidate and the best are double buffered: an improvement swaps them and the old best becomes the buffer
+    // of the next candidate.
+    bool compareResults(Clusters<T>& candidateClusters, Clusters<T>& bestClusters)
+    {
+        if (!(candidateClusters < bestClusters))
+            return false;
+
+        bestClusters.swap(candidateClusters);
+        return true;
+    }
+
+    // A matrix whose storage is recycled through the pool of this engine, for buffers that are allocated anew in
+    // every fit. Such matrices may be kept in the results, since the pool outlives them.
+    Matrix<T> pooledMatrix(const int64_t rows, const int64_t cols, const bool autoResize = false)
     {
-        if (candidateClusters < bestClusters)
-            bestClusters = std::move(candidateClusters);
+        Matrix<T> matrix(&m_pool);
+        matrix.reshape(rows, cols, autoResize);
+        return matrix;
     }
 
 protected:
+    BufferPool m_pool;
     Clusters<T> m_bestClusters;
 
 private:
+    FitWorkspace<T> m_workspace;
     std::unique_ptr<IInitializer<T>> p_initializer;
     std::unique_ptr<IMaximizer<T>> p_maximizer;
 };
@@ -11,32 +11,33 @@ template <typename T, Parallelism Level>
 class PAMSwap : public IMaximizer<T>
 {
 public:
-    void maximize(const Matrix<T>* const data, Clusters<T>* const clusters,
-                  const DistanceMatrix<T>* const distMat) const override
+    void maximize(const DataView<T>* const data, Clusters<T>* const clusters, const DistanceMatrix<T>* const distMat,
+                  ScratchBuffers<T>* const scratch) const override
     {
-        clusters->template calculateAssignmentsFromDistMat<Level>();
+        auto dissimilarityMat = &scratch->swapDissimilarities;
+        clusters->template calculateErrorFromDistMat<Level>();
         auto tolerance = -0.01 * (clusters->getError() / data->numRows());
 
         while (true)
         {
-            Matrix<T> dissimilarityMat(clusters->size(), data->rows(), true, std::numeric_limits<T>::max());
-            maximizeIter(&dissimilarityMat, data, clusters, distMat);
+            dissimilarityMat->reshape(clusters->size(), data->rows(), true, std::numeric_limits<T>::max());
+            maximizeIter(dissimilarityMat, data, clusters, distMat);
 
-            auto minDissimilarity = *min_element(dissimilarityMat.cbegin(), dissimilarityMat.cend());
+            auto minDissimilarity = *min_element(dissimilarityMat->cbegin(), dissimilarityMat->cend());
             if (minDissimilarity >= tolerance)
                 break;
 
-            auto coords = dissimilarityMat.find(minDissimilarity);
+            auto coords = dissimilarityMat->find(minDissimilarity);
             clusters->swapCentroid(coords.second, coords.first);
         }
 
-        clusters->template calculateAssignmentsFromDistMat<Level>();
+        clusters->template calculateErrorFromDistMat<Level>();
     }
 
 private:
     template <Parallelism _Level = Level>
     std::enable_if_t<_Level == Parallelism::Serial || _Level == Parallelism::MPI> maximizeIter(
-      Matrix<T>* const dissimilarityMat, const Matrix<T>* const data, Clusters<T>* const clusters,
+      Matrix<T>* const dissimilarityMat, const DataView<T>* const data, Clusters<T>* const clusters,
       const DistanceMatrix<T>* const distMat) const
     {
         for (int centroidIdx = 0; centroidIdx < clusters->size(); ++centroidIdx)
@@ -47,7 +48,7 @@ private:
 
     template <Parallelism _Level = Level>
     std::enable_if_t<_Level == Parallelism::OMP || _Level == Parallelism::Hybrid> maximizeIter(
-      Matrix<T>* const dissimilarityMat, const Matrix<T>* const data, Clusters<T>* const clusters,
+      Matrix<T>* const dissimilarityMat, const DataView<T>* const data, Clusters<T>* const clusters,
       const DistanceMatrix<T>* const distMat) const
     {
 #pragma omp parallel for schedule(static)
@@ -57,16 +58,12 @@ private:
         }
     }
 
-    void maximizeIterImpl(const int centroidIdx, Matrix<T>* const dissimilarityMat, const Matrix<T>* const data,
+    void maximizeIterImpl(const int centroidIdx, Matrix<T>* const dissimilarityMat, const DataView<T>* const data,
                           Clusters<T>* const clusters, const DistanceMatrix<T>* const distMat) const
     {
-        std::vector<T> totals(data->numRows(), std::numeric_limits<T>::max());
-        auto selected = clusters->selected();
-
         for (const auto& candidate : clusters->unselected())
         {
-            std::vector<T> contributionVec;
-            contributionVec.reserve(clusters->numCandidates() - 1);
+            auto total = 0.0;
             for (const auto& point : clusters->unselected())
             {
                 if (point != candidate)
@@ -76,19 +73,18 @@ private:
                     auto pointToCandidateDist       = distMat->distanceToPoint(candidate, point);
 
                     if (centroidToPointDist > pointToClosestCentroidDist)
-                        contributionVec.emplace_back(std::min(pointToCandidateDist - pointToClosestCentroidDist, 0.0));
+                        total += std::min(pointToCandidateDist - pointToClosestCentroidDist, 0.0);
                     else if (centroidToPointDist == pointToClosestCentroidDist)
                     {
                         auto range                            = distMat->getAllDistancesToCentroids(point);
                         auto pointToSecondClosestCentroidDist = getSecondLowest(range.first, range.second);
-                        contributionVec.emplace_back(std::min(pointToSecondClosestCentroidDist, pointToCandidateDist) -
-                                                     pointToClosestCentroidDist);
+                        total += std::min(pointToSecondClosestCentroidDist, pointToCandidateDist) -
+                                 pointToClosestCentroidDist;
                     }
                 }
             }
-            totals[candidate] = std::accumulate(contributionVec.cbegin(), contributionVec.cend(), 0.0);
+            dissimilarityMat->at(centroidIdx, candidate) = total;
         }
-        dissimilarityMat->set(centroidIdx, totals);
     }
 };
 }  // namespace hpkmedoids
\ No newline at end of file
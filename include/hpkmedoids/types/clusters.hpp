@@ -1,10 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <hpkmedoids/distances.hpp>
+#include <hpkmedoids/types/data_view.hpp>
 #include <hpkmedoids/types/distance_matrix.hpp>
 #include <hpkmedoids/types/selected_set.hpp>
+#include <hpkmedoids/utils/feature_major.hpp>
 #include <iostream>
 #include <matrix/matrix.hpp>
+#include <omp.h>
 #include <type_traits>
 namespace hpkmedoids
 {
@@ -17,9 +22,30 @@ public:
 
     Clusters();
 
-    Clusters(const Matrix<T>* const data, const Matrix<T>* const centroids);
+    Clusters(const DataView<T>& data, const Matrix<T>* const centroids);
 
-    Clusters(const Matrix<T>* const data, DistanceMatrix<T>* const distMat);
+    Clusters(const DataView<T>& data, Matrix<T>&& centroids, const T error,
+             std::vector<int32_t>&& assignments = std::vector<int32_t>());
+
+    Clusters(const DataView<T>& data, DistanceMatrix<T>* const distMat);
+
+    // Same as assigning Clusters(data, distMat), but keeps the allocations of the centroids, assignments and
+    // selected set.
+    void reset(const DataView<T>& data, DistanceMatrix<T>* const distMat);
+
+    // Same as assigning Clusters(), but keeps the allocations.
+    void clear();
+
+    // Points the centroids at other data, dropping everything that refers to the previous data.
+    void rebind(const DataView<T>& data);
+
+    // Exchanges the contents with other without copying any buffers. The layout and scratch space of the centroid
+    // searches stay with each object.
+    void swap(Clusters& other) noexcept;
+
+    // Refreshes the distances to the centroids in the distance matrix, which may have been overwritten by other
+    // clusters sharing it since these centroids were selected.
+    void restoreCentroidDistances();
 
     bool operator<(const Clusters& lhs) const;
 
@@ -39,12 +65,49 @@ public:
 
     int32_t numCandidates() const;
 
+    // Whether the point dataIdx is one of the centroids.
+    bool isSelected(const int32_t dataIdx) const;
+
     const Matrix<T>* const getCentroids() const;
 
+    // Indices of the medoids in the data the view is over.
+    std::vector<int32_t> getMedoidIndices() const;
+
     const std::vector<int32_t>* const getClustering() const;
 
     const T getError() const;
 
+    // Layout of the data in the centroid searches, Auto unless set.
+    void setLayout(const DataLayout layout);
+
+    // Same error as calculateAssignmentsFromDistMat, without writing the assignments.
+    template <Parallelism Level>
+    std::enable_if_t<Level == Parallelism::Serial || Level == Parallelism::MPI> calculateErrorFromDistMat()
+    {
+        T cost = 0.0;
+
+        for (int i = 0; i < static_cast<int32_t>(m_data.rows()); ++i)
+        {
+            cost += std::pow(p_distMat->distanceToClosestCentroid(i), 2);
+        }
+
+        m_error = cost;
+    }
+
+    template <Parallelism Level>
+    std::enable_if_t<Level == Parallelism::OMP || Level == Parallelism::Hybrid> calculateErrorFromDistMat()
+    {
+        T cost = 0.0;
+
+#pragma omp parallel for schedule(static), reduction(+ : cost)
+        for (int i = 0; i < static_cast<int32_t>(m_data.rows()); ++i)
+        {
+            cost += std::pow(p_distMat->distanceToClosestCentroid(i), 2);
+        }
+
+        m_error = cost;
+    }
+
     template <Parallelism Level>
     std::enable_if_t<Level == Parallelism::Serial || Level == Parallelism::MPI> calculateAssignmentsFromDistMat()
     {
@@ -79,13 +142,13 @@ public:
       DistanceFunc& distanceFunc)
     {
         T cost = 0.0;
+        m_assignments.resize(m_data.rows());
 
-        for (int32_t i = 0; i < p_data->rows(); ++i)
-        {
-            auto closestCentroid = findClosestCentroid(p_data->crowBegin(i), p_data->crowEnd(i), distanceFunc);
-            m_assignments[i]     = closestCentroid.idx;
-            cost += std::pow(closestCentroid.distance, 2);
-        }
+        forClosestCentroids(0, m_data.rows(), distanceFunc, blockBuffers(1),
+                            [&](const int32_t i, const ClosestCentroid& closestCentroid) {
+                                m_assignments[i] = closestCentroid.idx;
+                                cost += std::pow(closestCentroid.distance, 2);
+                            });
 
         m_error = cost;
     }
@@ -94,19 +157,96 @@ public:
     std::enable_if_t<Level == Parallelism::OMP || Level == Parallelism::Hybrid> calculateAssignmentsFromCentroids(
       DistanceFunc& distanceFunc)
     {
-        T cost = 0.0;
+        T cost    = 0.0;
+        auto rows = static_cast<int32_t>(m_data.rows());
+        m_assignments.resize(rows);
+        auto buffers = blockBuffers(omp_get_max_threads());
 
-#pragma omp parallel for schedule(static), reduction(+ : cost)
-        for (int32_t i = 0; i < p_data->rows(); ++i)
+#pragma omp parallel reduction(+ : cost)
         {
-            auto closestCentroid = findClosestCentroid(p_data->crowBegin(i), p_data->crowEnd(i), distanceFunc);
-            m_assignments[i]     = closestCentroid.idx;
-            cost += std::pow(closestCentroid.distance, 2);
+            auto threadBuffers = &buffers[omp_get_thread_num()];
+#pragma omp for schedule(static)
+            for (int32_t blockBegin = 0; blockBegin < rows; blockBegin += BATCH_BLOCK_SIZE)
+            {
+                forClosestCentroids(blockBegin, std::min(blockBegin + BATCH_BLOCK_SIZE, rows), distanceFunc,
+                                    threadBuffers,
+                                    [&](const int32_t i, const ClosestCentroid& closestCentroid) {
+                                        m_assignments[i] = closestCentroid.idx;
+                                        cost += std::pow(closestCentroid.distance, 2);
+                                    });
+            }
         }
 
         m_error = cost;
     }
 
+    // Computes the error of the centroids over the data in blocks of EVAL_BLOCK_SIZE points without materializing
+    // the assignments, abandoning the evaluation as soon as the partial error reaches bound. Returns true and sets
+    // the error if the centroids beat the bound, otherwise the error is left untouched.
+    template <Parallelism Level, class DistanceFunc>
+    std::enable_if_t<Level == Parallelism::Serial || Level == Parallelism::MPI, bool> calculateErrorFromCentroids(
+      DistanceFunc& distanceFunc, const T bound)
+    {
+        T cost    = 0.0;
+        auto rows = static_cast<int32_t>(m_data.rows());
+
+        for (int32_t blockBegin = 0; blockBegin < rows; blockBegin += EVAL_BLOCK_SIZE)
+        {
+            forClosestCentroids(blockBegin, std::min(blockBegin + EVAL_BLOCK_SIZE, rows), distanceFunc,
+                                blockBuffers(1),
+                                [&](const int32_t, const ClosestCentroid& closestCentroid) {
+                                    cost += std::pow(closestCentroid.distance, 2);
+                                });
+
+            if (cost >= bound)
+                return false;
+        }
+
+        m_error = cost;
+        return true;
+    }
+
+    template <Parallelism Level, class DistanceFunc>
+    std::enable_if_t<Level == Parallelism::OMP || Level == Parallelism::Hybrid, bool> calculateErrorFromCentroids(
+      DistanceFunc& distanceFunc, const T bound)
+    {
+        T cost       = 0.0;
+        auto rows    = static_cast<int32_t>(m_data.rows());
+        auto buffers = blockBuffers(omp_get_max_threads());
+
+        for (int32_t blockBegin = 0; blockBegin < rows; blockBegin += EVAL_BLOCK_SIZE)
+        {
+            auto blockEnd = std::min(blockBegin + EVAL_BLOCK_SIZE, rows);
+            T blockCost   = 0.0;
+
+#pragma omp parallel reduction(+ : blockCost)
+            {
+                auto threadBuffers = &buffers[omp_get_thread_num()];
+#pragma omp for schedule(static)
+                for (int32_t begin = blockBegin; begin < blockEnd; begin += BATCH_BLOCK_SIZE)
+                {
+                    forClosestCentroids(begin, std::min(begin + BATCH_BLOCK_SIZE, blockEnd), distanceFunc,
+                                        threadBuffers,
+                                        [&](const int32_t, const ClosestCentroid& closestCentroid) {
+                                            blockCost += std::pow(closestCentroid.distance, 2);
+                                        });
+                }
+            }
+
+            cost += blockCost;
+            if (cost >= bound)
+                return false;
+        }
+
+        m_error = cost;
+        return true;
+    }
+
+    static constexpr int32_t EVAL_BLOCK_SIZE = 4096;
+
+    // Points a thread works on at a time in the centroid searches.
+    static constexpr int32_t BATCH_BLOCK_SIZE = 128;
+
 private:
     struct ClosestCentroid
     {
@@ -139,12 +279,83 @@ private:
         return closestCentroid;
     }
 
+    // Per thread scratch space of the centroid searches. Only allocated when the data is searched feature-major,
+    // and kept across searches so that only the first one allocates.
+    struct BlockBuffers
+    {
+        Matrix<T> features;
+        Matrix<T> distances;
+
+        BlockBuffers() : features(Matrix<T>::uninitialized(0, 0, true)) {}
+    };
+
+    // Buffers for numThreads threads, indexed by thread number.
+    BlockBuffers* blockBuffers(const int32_t numThreads)
+    {
+        if (static_cast<int32_t>(m_blockBuffers.size()) < numThreads)
+            m_blockBuffers.resize(numThreads);
+
+        return m_blockBuffers.data();
+    }
+
+    // Calls visit(i, closest centroid of point i) for the points [begin, end) in order. Feature-major searches
+    // transpose DISTANCE_BATCH_SIZE points at a time and compute their distances to each centroid with a single call
+    // to the batch kernel of the distance function.
+    template <class DistanceFunc, class Visit>
+    void forClosestCentroids(const int32_t begin, const int32_t end, DistanceFunc& distanceFunc,
+                             BlockBuffers* const buffers, Visit visit)
+    {
+        if constexpr (HasBatchKernel<T, DistanceFunc>::value)
+        {
+            if (useFeatureMajor<T, DistanceFunc>(m_layout, m_data.cols()))
+            {
+                forClosestCentroidsBatched(begin, end, distanceFunc, buffers, visit);
+                return;
+            }
+        }
+
+        for (int32_t i = begin; i < end; ++i)
+        {
+            visit(i, findClosestCentroid(m_data.crowBegin(i), m_data.crowEnd(i), distanceFunc));
+        }
+    }
+
+    template <class DistanceFunc, class Visit>
+    void forClosestCentroidsBatched(const int32_t begin, const int32_t end, DistanceFunc& distanceFunc,
+                                    BlockBuffers* const buffers, Visit visit)
+    {
+        for (int32_t batchBegin = begin; batchBegin < end; batchBegin += DISTANCE_BATCH_SIZE)
+        {
+            auto count = static_cast<int32_t>(std::min<int64_t>(DISTANCE_BATCH_SIZE, end - batchBegin));
+            transposeRows(&m_data, batchBegin, count, &buffers->features);
+            buffers->distances.reshapeUninitialized(m_centroids.rows(), count);
+            for (int32_t c = 0; c < m_centroids.rows(); ++c)
+            {
+                distanceFunc.batch(m_centroids.crowBegin(c), m_centroids.crowEnd(c), buffers->features.data(),
+                                   buffers->features.ld(), count, buffers->distances.rowBegin(c));
+            }
+
+            for (int32_t j = 0; j < count; ++j)
+            {
+                ClosestCentroid closestCentroid;
+                for (int32_t c = 0; c < m_centroids.rows(); ++c)
+                {
+                    if (closestCentroid.isGreaterThan(buffers->distances.at(c, j)))
+                        closestCentroid.set(c, buffers->distances.at(c, j));
+                }
+                visit(batchBegin + j, closestCentroid);
+            }
+        }
+    }
+
 private:
     T m_error;
-    const Matrix<T>* p_data;
+    DataView<T> m_data;
     DistanceMatrix<T>* p_distMat;
     SelectedSet m_selectedSet;
     std::vector<int32_t> m_assignments;
     Matrix<T> m_centroids;
+    DataLayout m_layout;
+    std::vector<BlockBuffers> m_blockBuffers;
 };
 }  // namespace hpkmedoids
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <matrix/matrix.hpp>
+#include <matrix/matrix_view.hpp>
+#include <vector>
+
+namespace hpkmedoids
+{
+// Read-only view of the rows of a matrix, either all of them or the rows listed in an index array, in that order.
+// A sample is then just its list of indices into the original data and never has to be copied out. The base may be
+// a Matrix or any MatrixView, e.g. memory owned by the caller. The view holds pointers only, so the data and the
+// indices must outlive it.
+template <typename T>
+class DataView
+{
+public:
+    typedef typename MatrixView<T>::const_row_iterator const_row_iterator;
+
+    DataView() : p_indices(nullptr) {}
+
+    DataView(const Matrix<T>* const base) : m_base(*base), p_indices(nullptr) {}
+
+    DataView(const Matrix<T>* const base, const std::vector<int32_t>* const indices) :
+        m_base(*base), p_indices(indices)
+    {
+    }
+
+    DataView(const MatrixView<T>& base) : m_base(base), p_indices(nullptr) {}
+
+    DataView(const MatrixView<T>& base, const std::vector<int32_t>* const indices) : m_base(base), p_indices(indices)
+    {
+    }
+
+    int64_t rows() const noexcept { return p_indices == nullptr ? m_base.rows() : p_indices->size(); }
+
+    int64_t numRows() const noexcept { return rows(); }
+
+    int64_t cols() const noexcept { return m_base.cols(); }
+
+    // Row of the base matrix behind row of the view.
+    int32_t index(const int64_t row) const { return p_indices == nullptr ? row : (*p_indices)[row]; }
+
+    const_row_iterator crowBegin(const int64_t row) const { return m_base.crowBegin(index(row)); }
+
+    const_row_iterator crowEnd(const int64_t row) const { return m_base.crowEnd(index(row)); }
+
+    const MatrixView<T>& base() const { return m_base; }
+
+private:
+    MatrixView<T> m_base;
+    const std::vector<int32_t>* p_indices;
+};
+}  // namespace hpkmedoids
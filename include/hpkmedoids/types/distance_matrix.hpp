@@ -2,6 +2,8 @@
 
 #include <hpkmedoids/types/parallelism.hpp>
 #include <hpkmedoids/utils/distance_calculator.hpp>
+#include <hpkmedoids/utils/fill_rows.hpp>
+#include <limits>
 #include <matrix/matrix.hpp>
 #include <utility>
 
@@ -18,11 +20,23 @@ public:
 
     DistanceMatrix();
 
-    template <Parallelism Level, class DistanceFunc>
-    static DistanceMatrix<T> create(const Matrix<T>* const data, const int32_t numClusters)
+    template <Parallelism Level, class DistanceFunc, class Rows>
+    static DistanceMatrix<T> create(const Rows* const data, const int32_t numClusters)
+    {
+        DistanceMatrix<T> distMat;
+        distMat.template compute<Level, DistanceFunc>(data, numClusters);
+        return distMat;
+    }
+
+    // Recomputes the matrix for new data in place, so repeated fits reuse the buffers of the largest data seen,
+    // including the feature-major copy of the data.
+    template <Parallelism Level, class DistanceFunc, class Rows>
+    void compute(const Rows* const data, const int32_t numClusters)
     {
         DistanceCalculator<T, Level, DistanceFunc> distanceCalc;
-        return DistanceMatrix<T>(distanceCalc.calculateDistanceMatrix(data, data), numClusters);
+        distanceCalc.calculateDistanceMatrix(data, data, &m_dataDistMat, &m_features);
+        m_centroidDistMat.reshapeUninitialized(m_dataDistMat.rows(), numClusters);
+        fillRows<Level>(&m_centroidDistMat, std::numeric_limits<T>::max());
     }
 
     T distanceToClosestCentroid(const int32_t dataIdx) const;
@@ -45,11 +59,9 @@ public:
 
     int32_t numCentroids() const;
 
-private:
-    DistanceMatrix(Matrix<T>&& dataDistMat, const int32_t numClusters);
-
 private:
     Matrix<T> m_dataDistMat;
     Matrix<T> m_centroidDistMat;
+    Matrix<T> m_features;
 };
 }  // namespace hpkmedoids
\ No newline at end of file
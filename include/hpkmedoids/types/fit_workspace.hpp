@@ -0,0 +1,38 @@
+#pragma once
+
+#include <hpkmedoids/types/clusters.hpp>
+#include <hpkmedoids/types/distance_matrix.hpp>
+#include <matrix/matrix.hpp>
+#include <vector>
+
+namespace hpkmedoids
+{
+// Scratch space of the initializers, maximizers and distance calculations of a fit. They are passed the buffers
+// instead of keeping their own, so they stay stateless and can be shared.
+template <typename T>
+struct ScratchBuffers
+{
+    ScratchBuffers() : features(Matrix<T>::uninitialized(0, 0, true))
+    {
+        buildDissimilarities.setAllocationPolicy(Matrix<T>::AllocationPolicy::HugePages);
+    }
+
+    // The points by points gains of PAMBuild and their distance sums.
+    Matrix<T> buildDissimilarities;
+    std::vector<T> distanceSums;
+    // The centroids by points gains of PAMSwap.
+    Matrix<T> swapDissimilarities;
+    // The feature-major copy of the points the distances are computed to.
+    Matrix<T> features;
+};
+
+// Buffers of a single fit that are kept between fits. They grow to the largest data they have been used with and are
+// recomputed in place afterwards, so fitting same-sized data again, e.g. the samples of CLARA, does not allocate.
+template <typename T>
+struct FitWorkspace
+{
+    DistanceMatrix<T> distMat;
+    Clusters<T> clusters;
+    ScratchBuffers<T> scratch;
+};
+}  // namespace hpkmedoids
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace hpkmedoids
+{
+// How the distributed PAM implementation spreads its work across ranks.
+enum class PAMExecution
+{
+    PartitionedMatrix,  // every rank holds a block of rows of the distance matrix and all ranks run each restart
+    ParallelRestarts    // every rank holds the whole distance matrix and runs its own share of the restarts
+};
+}  // namespace hpkmedoids
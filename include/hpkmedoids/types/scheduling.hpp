@@ -0,0 +1,12 @@
+#pragma once
+
+namespace hpkmedoids
+{
+// How the distributed CLARA implementation hands samples to the worker ranks.
+enum class Scheduling
+{
+    MasterWorker,  // the master holds the data and sends every sample's rows to a worker
+    DataResident,  // every rank holds the data and the master only sends the sampled indices
+    Decentralized  // every rank, the master included, draws and fits its own samples from a shared counter
+};
+}  // namespace hpkmedoids
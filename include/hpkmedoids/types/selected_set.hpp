@@ -7,6 +7,9 @@
 
 namespace hpkmedoids
 {
+// Splits the indices [0, numData) into selected and unselected ones. Both are kept in dense vectors for iteration, in
+// no particular order for the unselected ones. Each index also records its position in its vector and whether it is
+// selected, so membership tests and moving an index between the two (by swapping it with the last element) are O(1).
 class SelectedSet
 {
 public:
@@ -19,13 +22,16 @@ public:
 
     SelectedSet(const int32_t numData, const int32_t numClusters);
 
+    // Same as constructing a new set, but keeps the allocations.
+    void reset(const int32_t numData, const int32_t numClusters);
+
     void select(const int32_t idx);
 
     void replaceSelected(const int32_t idx, const int32_t centroidIdx);
 
-    bool seleContains(const int32_t idx);
+    bool seleContains(const int32_t idx) const;
 
-    bool unseleContains(const int32_t idx);
+    bool unseleContains(const int32_t idx) const;
 
     iterator seleBegin();
 
@@ -55,9 +61,18 @@ public:
 
     int32_t maxSelectedSize() const;
 
+private:
+    void removeUnselected(const int32_t idx);
+
+    void appendUnselected(const int32_t idx);
+
+    bool inRange(const int32_t idx) const;
+
 private:
     int32_t m_numClusters;
     std::vector<int32_t> m_unselected;
     std::vector<int32_t> m_selected;
+    std::vector<int32_t> m_positions;
+    std::vector<bool> m_isSelected;
 };
 }  // namespace hpkmedoids
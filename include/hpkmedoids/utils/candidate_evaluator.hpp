@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <hpkmedoids/types/parallelism.hpp>
+#include <limits>
+#include <matrix/matrix.hpp>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace hpkmedoids
+{
+// Scores several candidate sets of centroids in a single pass over the data. The candidates are stacked row-wise in
+// one matrix, numClusters rows per candidate, so each block of data is streamed from memory once and compared against
+// every candidate while it is still in cache. Candidates whose partial error reaches bound are dropped from the pass
+// and reported with an error of std::numeric_limits<T>::max().
+template <typename T, Parallelism Level, class DistanceFunc>
+class CandidateEvaluator
+{
+public:
+    template <Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::Serial || _Level == Parallelism::MPI, std::vector<T>> evaluate(
+      const Matrix<T>* const data, const Matrix<T>* const candidates, const int32_t numClusters, const T bound) const
+    {
+        auto numCandidates = static_cast<int32_t>(candidates->numRows() / numClusters);
+        auto rows          = static_cast<int32_t>(data->rows());
+        std::vector<T> costs(numCandidates, 0.0);
+        std::vector<int32_t> active(numCandidates);
+        std::iota(active.begin(), active.end(), 0);
+
+        for (int32_t blockBegin = 0; blockBegin < rows && !active.empty(); blockBegin += BLOCK_SIZE)
+        {
+            auto blockEnd = std::min(blockBegin + BLOCK_SIZE, rows);
+            std::vector<T> blockCosts(active.size(), 0.0);
+
+            for (int32_t i = blockBegin; i < blockEnd; ++i)
+            {
+                accumulatePoint(i, data, candidates, numClusters, active, blockCosts.data());
+            }
+
+            updateActive(blockCosts, bound, costs, active);
+        }
+
+        return costs;
+    }
+
+    template <Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::OMP || _Level == Parallelism::Hybrid, std::vector<T>> evaluate(
+      const Matrix<T>* const data, const Matrix<T>* const candidates, const int32_t numClusters, const T bound) const
+    {
+        auto numCandidates = static_cast<int32_t>(candidates->numRows() / numClusters);
+        auto rows          = static_cast<int32_t>(data->rows());
+        std::vector<T> costs(numCandidates, 0.0);
+        std::vector<int32_t> active(numCandidates);
+        std::iota(active.begin(), active.end(), 0);
+
+        for (int32_t blockBegin = 0; blockBegin < rows && !active.empty(); blockBegin += BLOCK_SIZE)
+        {
+            auto blockEnd = std::min(blockBegin + BLOCK_SIZE, rows);
+            std::vector<T> blockCosts(active.size(), 0.0);
+            auto blockCostsPtr = blockCosts.data();
+            auto numActive     = blockCosts.size();
+
+#pragma omp parallel for schedule(static), reduction(+ : blockCostsPtr[:numActive])
+            for (int32_t i = blockBegin; i < blockEnd; ++i)
+            {
+                accumulatePoint(i, data, candidates, numClusters, active, blockCostsPtr);
+            }
+
+            updateActive(blockCosts, bound, costs, active);
+        }
+
+        return costs;
+    }
+
+    static constexpr int32_t BLOCK_SIZE = 4096;
+
+private:
+    void accumulatePoint(const int32_t pointIdx, const Matrix<T>* const data, const Matrix<T>* const candidates,
+                         const int32_t numClusters, const std::vector<int32_t>& active, T* const blockCosts) const
+    {
+        for (int32_t j = 0; j < static_cast<int32_t>(active.size()); ++j)
+        {
+            auto minDist = std::numeric_limits<T>::max();
+            auto first   = active[j] * numClusters;
+            for (int32_t centroidIdx = first; centroidIdx < first + numClusters; ++centroidIdx)
+            {
+                minDist = std::min(minDist, m_distanceFunc(data->crowBegin(pointIdx), data->crowEnd(pointIdx),
+                                                           candidates->crowBegin(centroidIdx),
+                                                           candidates->crowEnd(centroidIdx)));
+            }
+            blockCosts[j] += std::pow(minDist, 2);
+        }
+    }
+
+    void updateActive(const std::vector<T>& blockCosts, const T bound, std::vector<T>& costs,
+                      std::vector<int32_t>& active) const
+    {
+        std::vector<int32_t> stillActive;
+        stillActive.reserve(active.size());
+
+        for (int32_t j = 0; j < static_cast<int32_t>(active.size()); ++j)
+        {
+            costs[active[j]] += blockCosts[j];
+            if (costs[active[j]] >= bound)
+                costs[active[j]] = std::numeric_limits<T>::max();
+            else
+                stillActive.push_back(active[j]);
+        }
+
+        active.swap(stillActive);
+    }
+
+private:
+    DistanceFunc m_distanceFunc;
+};
+}  // namespace hpkmedoids
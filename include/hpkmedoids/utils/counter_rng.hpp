@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace hpkmedoids
+{
+// Counter-based random number generator. The n-th value of a stream is a pure function of the seed, the stream id and
+// n, so any thread or rank can reproduce the values of any stream without sharing generator state, and disjoint
+// streams can be handed out per sample, thread or rank.
+class CounterRNG
+{
+public:
+    typedef uint64_t result_type;
+
+    CounterRNG(const uint64_t seed, const uint64_t stream) : m_key(mix(seed + mix(stream + GOLDEN_GAMMA))), m_counter(0)
+    {
+    }
+
+    result_type operator()() { return mix(m_key + GOLDEN_GAMMA * ++m_counter); }
+
+    // Unbiased integer in [0, bound) using Lemire's multiply-and-reject method.
+    uint32_t uniform(const uint32_t bound)
+    {
+        auto product = static_cast<uint64_t>(static_cast<uint32_t>(operator()() >> 32)) * bound;
+        if (static_cast<uint32_t>(product) < bound)
+        {
+            uint32_t threshold = -bound % bound;
+            while (static_cast<uint32_t>(product) < threshold)
+                product = static_cast<uint64_t>(static_cast<uint32_t>(operator()() >> 32)) * bound;
+        }
+
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+private:
+    // SplitMix64 finalizer
+    static uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    static constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15ULL;
+
+    uint64_t m_key;
+    uint64_t m_counter;
+};
+}  // namespace hpkmedoids
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <hpkmedoids/utils/shared_window.hpp>
+#include <hpkmedoids/utils/utils.hpp>
+#include <matrix/matrix.hpp>
+#include <vector>
+
+namespace hpkmedoids
+{
+// Splits the rows of a matrix into contiguous blocks, one per rank, and moves data and per-row results between the
+// blocks and a root rank, or assembles a matrix from the blocks it was loaded in. Counts are expressed in rows through
+// a row datatype so that matrices with more than INT_MAX elements can still be distributed. Copies made on other ranks
+// have padded rows if the source has.
+template <typename T>
+class DataDistributor
+{
+public:
+    DataDistributor() :
+        m_rank(-1), m_size(-1), m_numRows(0), m_dtype(matchMPIType<T>()), m_residentBuffer(nullptr), m_residentHash(0)
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &m_rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &m_size);
+    }
+
+    Matrix<T> scatter(const Matrix<T>* const data, const int root)
+    {
+        int64_t dims[3] = { data->rows(), data->cols(), data->ld() != data->cols() };
+        MPI_Bcast(dims, 3, MPI_INT64_T, root, MPI_COMM_WORLD);
+        partition(dims[0]);
+
+        Matrix<T> localData(rowCount(), dims[1], true, 0.0, dims[2]);
+        auto rowType = createRowType(dims[1], localData.ld());
+        MPI_Scatterv(data->data(), m_rowCounts.data(), m_rowDispls.data(), rowType, localData.data(), rowCount(),
+                     rowType, root, MPI_COMM_WORLD);
+        MPI_Type_free(&rowType);
+
+        return localData;
+    }
+
+    // Makes the matrix held by root available on every rank, receiving it into buffer on the others. Nothing is sent
+    // if the last replication into buffer was of the same contents. Returns the local copy.
+    const Matrix<T>* replicate(const Matrix<T>* const data, Matrix<T>* const buffer, const int root)
+    {
+        int64_t dims[3] = { data->rows(), data->cols(), data->ld() != data->cols() };
+        MPI_Bcast(dims, 3, MPI_INT64_T, root, MPI_COMM_WORLD);
+        auto hash = rootHash(data, root);
+        auto replica = m_rank == root ? data : buffer;
+        if (residentEverywhere(m_rank != root, buffer, hash))
+            return replica;
+
+        if (m_rank != root)
+            *buffer = Matrix<T>(dims[0], dims[1], true, 0.0, dims[2]);
+
+        broadcast(const_cast<T*>(replica->data()), dims[0] * replica->ld(), root);
+        markResident(buffer, hash);
+        return replica;
+    }
+
+    // As replicate, but keeps a single copy per node in a shared memory window: root copies the matrix into its
+    // node's window and the node leaders receive it into theirs. buffer is set to a view of the window, which must not
+    // outlive this distributor and whose rows are never padded. Root keeps using its own matrix.
+    const Matrix<T>* replicateShared(const Matrix<T>* const data, Matrix<T>* const buffer, const int root)
+    {
+        int64_t dims[2] = { data->rows(), data->cols() };
+        MPI_Bcast(dims, 2, MPI_INT64_T, root, MPI_COMM_WORLD);
+        auto hash = rootHash(data, root);
+        if (residentEverywhere(m_rank != root, buffer, hash))
+            return m_rank == root ? data : buffer;
+
+        *buffer = m_sharedWindow.allocate(dims[0], dims[1], root);
+        m_sharedWindow.synchronize();
+
+        if (m_rank == root)
+        {
+            for (int64_t i = 0; i < dims[0]; ++i)
+            {
+                buffer->set(i, data->crowBegin(i), data->crowEnd(i));
+            }
+        }
+        if (m_sharedWindow.isNodeLeader())
+            broadcast(buffer->data(), dims[0] * dims[1], 0, m_sharedWindow.leaderComm());
+
+        m_sharedWindow.synchronize();
+        markResident(buffer, hash);
+        return m_rank == root ? data : buffer;
+    }
+
+    // Collective. Assembles a matrix whose rows are already split across the ranks, localData being the calling
+    // rank's block of its numRows rows, once per node in the shared memory window of replicateShared. Every rank copies
+    // its block into its node's window and the node leaders then broadcast the blocks of their node to the other
+    // leaders, so no rank receives more than the rows held on other nodes. Nothing is sent if buffer still holds the
+    // same contents. Returns buffer, which is set to a view of the window.
+    const Matrix<T>* replicateSlices(const Matrix<T>* const localData, const int64_t numRows, Matrix<T>* const buffer)
+    {
+        partitionSlices(localData, numRows);
+        auto hash = slicesHash(localData);
+        if (residentEverywhere(true, buffer, hash))
+            return buffer;
+
+        std::vector<int> leaders(m_size);
+        *buffer     = m_sharedWindow.allocate(numRows, localData->cols(), 0);
+        auto leader = m_sharedWindow.leaderRank();
+        MPI_Allgather(&leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, MPI_COMM_WORLD);
+        m_sharedWindow.synchronize();
+
+        for (int64_t i = 0; i < rowCount(); ++i)
+        {
+            buffer->set(rowOffset() + i, localData->crowBegin(i), localData->crowEnd(i));
+        }
+        m_sharedWindow.synchronize();
+
+        if (m_sharedWindow.isNodeLeader())
+        {
+            for (int i = 0; i < m_size; ++i)
+            {
+                broadcast(buffer->data() + m_rowDispls[i] * buffer->ld(), m_rowCounts[i] * buffer->ld(), leaders[i],
+                          m_sharedWindow.leaderComm());
+            }
+        }
+
+        m_sharedWindow.synchronize();
+        markResident(buffer, hash);
+        return buffer;
+    }
+
+    // Collective. As replicateSlices, but assembles the matrix on root only, into buffer, with a single MPI_Gatherv.
+    // Returns buffer, which stays as it is on the other ranks.
+    const Matrix<T>* gatherSlices(const Matrix<T>* const localData, const int64_t numRows, Matrix<T>* const buffer,
+                                  const int root)
+    {
+        partitionSlices(localData, numRows);
+        auto hash = slicesHash(localData);
+        if (residentEverywhere(m_rank == root, buffer, hash))
+            return buffer;
+
+        if (m_rank == root)
+            *buffer = Matrix<T>(numRows, localData->cols(), true, 0.0, localData->ld() != localData->cols());
+
+        auto sendType = createRowType(localData->cols(), localData->ld());
+        auto recvType = createRowType(localData->cols(), m_rank == root ? buffer->ld() : localData->ld());
+        MPI_Gatherv(localData->data(), rowCount(), sendType, buffer->data(), m_rowCounts.data(), m_rowDispls.data(),
+                    recvType, root, MPI_COMM_WORLD);
+        MPI_Type_free(&recvType);
+        MPI_Type_free(&sendType);
+
+        markResident(buffer, hash);
+        return buffer;
+    }
+
+    // Copies the block of rows owned by the calling rank out of a matrix that is resident on every rank.
+    Matrix<T> localBlock(const Matrix<T>* const data)
+    {
+        partition(data->rows());
+
+        Matrix<T> localData(rowCount(), data->cols(), false, 0.0, data->ld() != data->cols());
+        for (int64_t i = rowOffset(); i < rowOffset() + rowCount(); ++i)
+        {
+            localData.append(data->crowBegin(i), data->crowEnd(i));
+        }
+
+        return localData;
+    }
+
+    // MPI_Bcast in chunks of at most BCAST_CHUNK_BYTES, which keeps the element counts within an int and lets large
+    // buffers be pipelined by the MPI implementation.
+    void broadcast(T* const buffer, const int64_t count, const int root, MPI_Comm comm = MPI_COMM_WORLD) const
+    {
+        const int64_t chunkSize = BCAST_CHUNK_BYTES / static_cast<int64_t>(sizeof(T));
+        for (int64_t offset = 0; offset < count; offset += chunkSize)
+        {
+            auto chunk = static_cast<int>(std::min(chunkSize, count - offset));
+            MPI_Bcast(buffer + offset, chunk, m_dtype, root, comm);
+        }
+    }
+
+    std::vector<int32_t> gather(const std::vector<int32_t>& localValues, const int root) const
+    {
+        std::vector<int32_t> values(m_rank == root ? m_numRows : 0);
+        MPI_Gatherv(localValues.data(), static_cast<int>(localValues.size()), MPI_INT32_T, values.data(),
+                    m_rowCounts.data(), m_rowDispls.data(), MPI_INT32_T, root, MPI_COMM_WORLD);
+        return values;
+    }
+
+    int rowCount() const { return m_rowCounts[m_rank]; }
+
+    int rowOffset() const { return m_rowDispls[m_rank]; }
+
+    static constexpr int64_t BCAST_CHUNK_BYTES = 64 << 20;
+
+private:
+    static constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+
+    // FNV-1a over the elements and the shape of the matrix, skipping padding, so that replicas with and without
+    // padded rows hash alike.
+    static uint64_t contentHash(const Matrix<T>* const data)
+    {
+        auto hash = mixHash(mixHash(FNV_OFFSET, data->rows()), data->cols());
+        for (int64_t i = 0; i < data->rows(); ++i)
+        {
+            for (auto it = data->crowBegin(i); it != data->crowEnd(i); ++it)
+            {
+                uint64_t word = 0;
+                std::memcpy(&word, &*it, sizeof(T));
+                hash = mixHash(hash, word);
+            }
+        }
+
+        return hash;
+    }
+
+    static uint64_t mixHash(const uint64_t hash, const uint64_t word) { return (hash ^ word) * 1099511628211ull; }
+
+    // Combines the hashes of the slices of every rank, so that all ranks agree on it.
+    uint64_t slicesHash(const Matrix<T>* const localData) const
+    {
+        std::vector<uint64_t> hashes(m_size);
+        auto hash = contentHash(localData);
+        MPI_Allgather(&hash, 1, MPI_UINT64_T, hashes.data(), 1, MPI_UINT64_T, MPI_COMM_WORLD);
+
+        hash = FNV_OFFSET;
+        for (const auto sliceHash : hashes)
+        {
+            hash = mixHash(hash, sliceHash);
+        }
+
+        return hash;
+    }
+
+    // Partitions numRows rows and aborts if any rank's slice is not the block the partition gives it.
+    void partitionSlices(const Matrix<T>* const localData, const int64_t numRows)
+    {
+        partition(numRows);
+
+        int matches = localData->rows() == rowCount();
+        MPI_Allreduce(MPI_IN_PLACE, &matches, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+        if (!matches)
+        {
+            if (m_rank == 0)
+                std::cerr << "The slices do not match the row partition of " << numRows << " rows" << std::endl;
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    }
+
+    uint64_t rootHash(const Matrix<T>* const data, const int root) const
+    {
+        uint64_t hash = m_rank == root ? contentHash(data) : 0;
+        MPI_Bcast(&hash, 1, MPI_UINT64_T, root, MPI_COMM_WORLD);
+        return hash;
+    }
+
+    // Whether every rank that needs a copy still holds the contents with the given hash in buffer.
+    bool residentEverywhere(const bool needsCopy, const Matrix<T>* const buffer, const uint64_t hash) const
+    {
+        int resident = !needsCopy || (buffer == m_residentBuffer && hash == m_residentHash);
+        MPI_Allreduce(MPI_IN_PLACE, &resident, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+        return resident;
+    }
+
+    void markResident(const Matrix<T>* const buffer, const uint64_t hash)
+    {
+        m_residentBuffer = buffer;
+        m_residentHash   = hash;
+    }
+
+    void partition(const int64_t numRows)
+    {
+        m_numRows = numRows;
+        m_rowCounts.resize(m_size);
+        m_rowDispls.resize(m_size);
+
+        for (int i = 0; i < m_size; ++i)
+        {
+            m_rowCounts[i] = static_cast<int>(numRows / m_size + (i < numRows % m_size ? 1 : 0));
+            m_rowDispls[i] = i == 0 ? 0 : m_rowDispls[i - 1] + m_rowCounts[i - 1];
+        }
+    }
+
+    // A row of cols elements spanning ld elements, so that padded rows are skipped over in memory.
+    MPI_Datatype createRowType(const int64_t cols, const int64_t ld) const
+    {
+        MPI_Datatype row, rowType;
+        MPI_Type_contiguous(static_cast<int>(cols), m_dtype, &row);
+        MPI_Type_create_resized(row, 0, ld * static_cast<MPI_Aint>(sizeof(T)), &rowType);
+        MPI_Type_commit(&rowType);
+        MPI_Type_free(&row);
+        return rowType;
+    }
+
+private:
+    int m_rank;
+    int m_size;
+    int64_t m_numRows;
+    std::vector<int> m_rowCounts;
+    std::vector<int> m_rowDispls;
+    MPI_Datatype m_dtype;
+    SharedWindow<T> m_sharedWindow;
+    // The buffer last replicated into and the hash of its contents.
+    const Matrix<T>* m_residentBuffer;
+    uint64_t m_residentHash;
+};
+}  // namespace hpkmedoids
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <hpkmedoids/types/parallelism.hpp>
+#include <hpkmedoids/utils/feature_major.hpp>
+#include <limits>
 #include <matrix/matrix.hpp>
 #include <type_traits>
 
@@ -10,44 +13,99 @@ template <typename T, Parallelism Level, class DistanceFunc>
 class DistanceCalculator
 {
 public:
-    template <Parallelism _Level = Level>
-    std::enable_if_t<_Level == Parallelism::Serial || _Level == Parallelism::MPI, Matrix<T>> calculateDistanceMatrix(
-      const Matrix<T>* const mat1, const Matrix<T>* const mat2) const
+    DistanceCalculator(const DataLayout layout = DataLayout::Auto) : m_layout(layout) {}
+
+    // As below, transposing mat2 into a buffer that only lives for the call.
+    template <class Rows1, class Rows2>
+    void calculateDistanceMatrix(const Rows1* const mat1, const Rows2* const mat2, Matrix<T>* const distanceMat) const
+    {
+        auto features = Matrix<T>::uninitialized(0, 0, true);
+        calculateDistanceMatrix(mat1, mat2, distanceMat, &features);
+    }
+
+    // Rows1 and Rows2 may be a Matrix<T>, a MatrixView<T> or a DataView<T>.
+    template <class Rows1, class Rows2>
+    Matrix<T> calculateDistanceMatrix(const Rows1* const mat1, const Rows2* const mat2) const
+    {
+        Matrix<T> distanceMat;
+        calculateDistanceMatrix(mat1, mat2, &distanceMat);
+        return distanceMat;
+    }
+
+    // Writes the distances into distanceMat, reusing its allocation when it is large enough. The matrix is not
+    // initialized beforehand, so with OMP every row is first touched by the thread that computes it. With the
+    // feature-major layout mat2 is transposed once into features, which is reshaped in place so that callers keeping
+    // it reuse its allocation, and every row is computed by a single call to the batch kernel.
+    template <class Rows1, class Rows2, Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::Serial || _Level == Parallelism::MPI> calculateDistanceMatrix(
+      const Rows1* const mat1, const Rows2* const mat2, Matrix<T>* const distanceMat, Matrix<T>* const features) const
     {
-        Matrix<T> distanceMat(mat1->rows(), mat2->rows(), true, std::numeric_limits<T>::max());
+        distanceMat->reshapeUninitialized(mat1->rows(), mat2->rows());
+        auto featureMajor = prepareFeatures(mat2, features);
 
         for (int i = 0; i < mat1->rows(); ++i)
         {
-            for (int j = 0; j < mat2->numRows(); ++j)
-            {
-                distanceMat.at(i, j) =
-                  m_distanceFunc(mat1->crowBegin(i), mat1->crowEnd(i), mat2->crowBegin(j), mat2->crowEnd(j));
-            }
+            calculateRow(mat1, i, mat2, featureMajor ? features : nullptr, distanceMat);
         }
-
-        return distanceMat;
     }
 
-    template <Parallelism _Level = Level>
-    std::enable_if_t<_Level == Parallelism::OMP || _Level == Parallelism::Hybrid, Matrix<T>> calculateDistanceMatrix(
-      const Matrix<T>* const mat1, const Matrix<T>* const mat2) const
+    template <class Rows1, class Rows2, Parallelism _Level = Level>
+    std::enable_if_t<_Level == Parallelism::OMP || _Level == Parallelism::Hybrid> calculateDistanceMatrix(
+      const Rows1* const mat1, const Rows2* const mat2, Matrix<T>* const distanceMat, Matrix<T>* const features) const
     {
-        Matrix<T> distanceMat(mat1->rows(), mat2->rows(), true, std::numeric_limits<T>::max());
+        distanceMat->reshapeUninitialized(mat1->rows(), mat2->rows());
+        auto featureMajor = prepareFeatures(mat2, features);
 
-#pragma omp parallel for shared(distanceMat), schedule(static)
+#pragma omp parallel for schedule(static)
         for (int i = 0; i < mat1->rows(); ++i)
+        {
+            calculateRow(mat1, i, mat2, featureMajor ? features : nullptr, distanceMat);
+        }
+    }
+
+    void setLayout(const DataLayout layout) { m_layout = layout; }
+
+private:
+    template <class Rows>
+    bool prepareFeatures(const Rows* const mat2, Matrix<T>* const features) const
+    {
+        if (!useFeatureMajor<T, DistanceFunc>(m_layout, mat2->cols()))
+            return false;
+
+        transposeRows(mat2, 0, mat2->numRows(), features);
+        return true;
+    }
+
+    // features is null unless the row is computed from the feature-major copy of mat2.
+    template <class Rows1, class Rows2>
+    void calculateRow(const Rows1* const mat1, const int i, const Rows2* const mat2, const Matrix<T>* const features,
+                      Matrix<T>* const distanceMat) const
+    {
+        auto batched = false;
+        if constexpr (HasBatchKernel<T, DistanceFunc>::value)
+        {
+            if (features)
+            {
+                m_distanceFunc.batch(mat1->crowBegin(i), mat1->crowEnd(i), features->data(), features->ld(),
+                                     mat2->numRows(), distanceMat->rowBegin(i));
+                batched = true;
+            }
+        }
+
+        if (!batched)
         {
             for (int j = 0; j < mat2->numRows(); ++j)
             {
-                distanceMat.at(i, j) =
+                distanceMat->at(i, j) =
                   m_distanceFunc(mat1->crowBegin(i), mat1->crowEnd(i), mat2->crowBegin(j), mat2->crowEnd(j));
             }
         }
 
-        return distanceMat;
+        std::fill(distanceMat->rowBegin(i) + mat2->numRows(), distanceMat->rowEnd(i), std::numeric_limits<T>::max());
     }
 
 private:
+    DataLayout m_layout;
     DistanceFunc m_distanceFunc;
 };
 }  // namespace hpkmedoids
\ No newline at end of file
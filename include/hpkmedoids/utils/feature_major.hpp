@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <matrix/matrix.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace hpkmedoids
+{
+// Row-major data with few features keeps every distance to a short loop that cannot be vectorized. Feature-major
+// copies hold one contiguous array per feature instead, so that the batch kernel a distance function provides next to
+// its row kernel can compute the distances from one point to many points at once across SIMD lanes.
+enum class DataLayout
+{
+    Auto,
+    RowMajor,
+    FeatureMajor
+};
+
+// Auto uses the feature-major kernels up to this many features.
+constexpr int64_t FEATURE_MAJOR_MAX_COLS = 16;
+
+inline bool useFeatureMajor(const DataLayout layout, const int64_t cols)
+{
+    return layout == DataLayout::FeatureMajor || (layout == DataLayout::Auto && cols <= FEATURE_MAJOR_MAX_COLS);
+}
+
+// Whether DistanceFunc has a batch kernel for T, see L1Norm::batch.
+template <typename T, class DistanceFunc, typename = void>
+struct HasBatchKernel : std::false_type
+{
+};
+
+template <typename T, class DistanceFunc>
+struct HasBatchKernel<T, DistanceFunc,
+                      std::void_t<decltype(std::declval<const DistanceFunc&>().batch(
+                        std::declval<const T*>(), std::declval<const T*>(), std::declval<const T*>(), int64_t(),
+                        int64_t(), std::declval<T*>()))>> : std::true_type
+{
+};
+
+// As above, but distance functions without a batch kernel are always evaluated row by row.
+template <typename T, class DistanceFunc>
+bool useFeatureMajor(const DataLayout layout, const int64_t cols)
+{
+    return HasBatchKernel<T, DistanceFunc>::value && useFeatureMajor(layout, cols);
+}
+
+// Copies count rows of data starting at row begin into features, feature f of row begin + j at features->at(f, j).
+// Rows may be a Matrix<T>, a MatrixView<T> or a DataView<T>.
+template <typename T, class Rows>
+void transposeRows(const Rows* const data, const int64_t begin, const int64_t count, Matrix<T>* const features)
+{
+    features->reshapeUninitialized(data->cols(), count);
+    for (int64_t j = 0; j < count; ++j)
+    {
+        auto row = data->crowBegin(begin + j);
+        for (int64_t f = 0; f < data->cols(); ++f)
+        {
+            features->at(f, j) = row[f];
+        }
+    }
+}
+}  // namespace hpkmedoids
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <algorithm>
+#include <hpkmedoids/types/parallelism.hpp>
+#include <matrix/matrix.hpp>
+#include <type_traits>
+
+namespace hpkmedoids
+{
+// Sets the rows of a matrix to fillVal and their padding to zero. The OMP version splits the rows with the static
+// schedule used by the loops that later work on the matrix, so when the matrix comes uninitialized from
+// Matrix::uninitialized or Matrix::reshapeUninitialized this is its parallel first touch: on NUMA systems every page
+// is placed on the node of the thread that will use it.
+template <Parallelism Level, typename T>
+std::enable_if_t<Level == Parallelism::Serial || Level == Parallelism::MPI> fillRows(
+  Matrix<T>* const matrix, const T fillVal)
+{
+    for (int64_t i = 0; i < matrix->rows(); ++i)
+    {
+        std::fill(matrix->rowBegin(i), matrix->rowEnd(i), fillVal);
+        std::fill(matrix->rowEnd(i), matrix->at(i) + matrix->ld(), static_cast<T>(0));
+    }
+}
+
+template <Parallelism Level, typename T>
+std::enable_if_t<Level == Parallelism::OMP || Level == Parallelism::Hybrid> fillRows(
+  Matrix<T>* const matrix, const T fillVal)
+{
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < matrix->rows(); ++i)
+    {
+        std::fill(matrix->rowBegin(i), matrix->rowEnd(i), fillVal);
+        std::fill(matrix->rowEnd(i), matrix->at(i) + matrix->ld(), static_cast<T>(0));
+    }
+}
+}  // namespace hpkmedoids
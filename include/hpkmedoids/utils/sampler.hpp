@@ -1,8 +1,11 @@
 #pragma once
 
+#include <hpkmedoids/filesystem/disk_rows.hpp>
+#include <hpkmedoids/types/parallelism.hpp>
 #include <hpkmedoids/utils/uniform_selectors.hpp>
 #include <matrix/matrix.hpp>
 #include <type_traits>
+#include <vector>
 
 namespace hpkmedoids
 {
@@ -10,40 +13,78 @@ template <typename T>
 class Sampler
 {
 public:
-    template <Parallelism Level>
-    std::enable_if_t<Level == Parallelism::Serial || Level == Parallelism::MPI, Matrix<T>> sample(
-      const int32_t sampleSize, const Matrix<T>* const data)
+    // Rows may be a Matrix<T>, a MatrixView<T> or a DataView<T>.
+    template <Parallelism Level, class Rows>
+    Matrix<T> sample(const int32_t sampleSize, const Rows* const data) const
     {
-        Matrix<T> sampledData(sampleSize, data->cols());
-
-        auto selections = m_selector.select(sampleSize, data->rows());
-        for (const auto& selection : selections)
-        {
-            sampledData.append(data->crowBegin(selection), data->crowEnd(selection));
-        }
-
+        Matrix<T> sampledData(sampleSize, data->cols(), true);
+        gather<Level>(select(sampleSize, data->rows()), data, &sampledData);
         return sampledData;
     }
 
     template <Parallelism Level>
-    std::enable_if_t<Level == Parallelism::OMP || Level == Parallelism::Hybrid, Matrix<T>> sample(
-      const int32_t sampleSize, const Matrix<T>* const data)
+    Matrix<T> sample(const int32_t sampleSize, const DiskRows<T>* const data) const
     {
         Matrix<T> sampledData(sampleSize, data->cols(), true);
+        gather<Level>(select(sampleSize, data->rows()), data, &sampledData);
+        return sampledData;
+    }
 
-        auto selections = m_selector.select(sampleSize, data->rows());
-        std::vector<int32_t> selectionVec(selections.cbegin(), selections.cend());
+    std::vector<int32_t> select(const int32_t sampleSize, const int32_t containerSize) const
+    {
+        return m_selector.select(sampleSize, containerSize);
+    }
+
+    std::vector<int32_t> select(const int32_t sampleSize, const int32_t containerSize, const uint64_t stream) const
+    {
+        return m_selector.select(sampleSize, containerSize, stream);
+    }
+
+    void select(const int32_t sampleSize, const int32_t containerSize, std::vector<int32_t>& selections) const
+    {
+        m_selector.select(sampleSize, containerSize, selections);
+    }
 
-#pragma omp parallel for shared(sampledData, selectionVec, selections), schedule(static)
-        for (int i = 0; i < static_cast<int>(selectionVec.size()); ++i)
+    void select(const int32_t sampleSize, const int32_t containerSize, const uint64_t stream,
+                std::vector<int32_t>& selections) const
+    {
+        m_selector.select(sampleSize, containerSize, stream, selections);
+    }
+
+    int64_t getSeed() const { return m_selector.getSeed(); }
+
+    void setSeed(const int64_t seed) { m_selector.setSeed(seed); }
+
+    template <Parallelism Level, class Rows>
+    std::enable_if_t<Level == Parallelism::Serial || Level == Parallelism::MPI> gather(
+      const std::vector<int32_t>& selections, const Rows* const data, Matrix<T>* const sampledData) const
+    {
+        for (int i = 0; i < static_cast<int>(selections.size()); ++i)
         {
-            sampledData.set(i, data->crowBegin(selectionVec[i]), data->crowEnd(selectionVec[i]));
+            sampledData->set(i, data->crowBegin(selections[i]), data->crowEnd(selections[i]));
         }
+    }
 
-        return sampledData;
+    template <Parallelism Level, class Rows>
+    std::enable_if_t<Level == Parallelism::OMP || Level == Parallelism::Hybrid> gather(
+      const std::vector<int32_t>& selections, const Rows* const data, Matrix<T>* const sampledData) const
+    {
+#pragma omp parallel for shared(sampledData, selections), schedule(static)
+        for (int i = 0; i < static_cast<int>(selections.size()); ++i)
+        {
+            sampledData->set(i, data->crowBegin(selections[i]), data->crowEnd(selections[i]));
+        }
+    }
+
+    // Fetches the selected rows from disk, see DiskRows::gather.
+    template <Parallelism Level>
+    void gather(const std::vector<int32_t>& selections, const DiskRows<T>* const data,
+                Matrix<T>* const sampledData) const
+    {
+        data->template gather<Level>(selections, sampledData);
     }
 
 private:
     UniformSelector m_selector;
 };
-}  // namespace hpkmedoids
\ No newline at end of file
+}  // namespace hpkmedoids
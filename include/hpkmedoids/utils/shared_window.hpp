@@ -0,0 +1,121 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <matrix/matrix.hpp>
+
+namespace hpkmedoids
+{
+// Holds a matrix once per node in an MPI-3 shared memory window. The ranks of a node are grouped with
+// MPI_Comm_split_type, the lowest rank of each node (the root is always one) allocates the whole window and the
+// others map it with MPI_Win_shared_query, so every rank gets a non-owning Matrix over the same memory. Node
+// leaders are also grouped into their own communicator so that data can be moved between nodes once per node.
+template <typename T>
+class SharedWindow
+{
+public:
+    SharedWindow() :
+        m_nodeComm(MPI_COMM_NULL),
+        m_leaderComm(MPI_COMM_NULL),
+        m_window(MPI_WIN_NULL),
+        m_nodeRank(-1),
+        m_leaderRank(-1),
+        m_rows(0),
+        m_cols(0),
+        p_base(nullptr)
+    {
+    }
+
+    SharedWindow(const SharedWindow&) = delete;
+
+    SharedWindow& operator=(const SharedWindow&) = delete;
+
+    ~SharedWindow()
+    {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (finalized)
+            return;
+
+        freeWindow();
+        if (m_leaderComm != MPI_COMM_NULL)
+            MPI_Comm_free(&m_leaderComm);
+        if (m_nodeComm != MPI_COMM_NULL)
+            MPI_Comm_free(&m_nodeComm);
+    }
+
+    // Collective over MPI_COMM_WORLD. Returns a matrix over node-shared memory, reusing the current window when it
+    // already has the requested shape. Writes by the node leader become visible to the node after synchronize().
+    Matrix<T> allocate(const int64_t rows, const int64_t cols, const int root)
+    {
+        createCommunicators(root);
+
+        if (m_window == MPI_WIN_NULL || rows != m_rows || cols != m_cols)
+        {
+            freeWindow();
+
+            MPI_Aint bytes = isNodeLeader() ? rows * cols * static_cast<MPI_Aint>(sizeof(T)) : 0;
+            T* localBase;
+            MPI_Win_allocate_shared(bytes, sizeof(T), MPI_INFO_NULL, m_nodeComm, &localBase, &m_window);
+
+            MPI_Aint leaderBytes;
+            int dispUnit;
+            MPI_Win_shared_query(m_window, 0, &leaderBytes, &dispUnit, &p_base);
+            m_rows = rows;
+            m_cols = cols;
+        }
+
+        return Matrix<T>(p_base, m_rows, m_cols);
+    }
+
+    void synchronize() const
+    {
+        MPI_Win_fence(0, m_window);
+    }
+
+    bool isNodeLeader() const { return m_nodeRank == 0; }
+
+    // Only valid on node leaders. The root has rank 0 in it.
+    MPI_Comm leaderComm() const { return m_leaderComm; }
+
+    // The rank in leaderComm of the calling rank's node leader.
+    int leaderRank() const { return m_leaderRank; }
+
+private:
+    void createCommunicators(const int root)
+    {
+        if (m_nodeComm != MPI_COMM_NULL)
+            return;
+
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        auto key = rank == root ? -1 : rank;
+
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, key, MPI_INFO_NULL, &m_nodeComm);
+        MPI_Comm_rank(m_nodeComm, &m_nodeRank);
+        MPI_Comm_split(MPI_COMM_WORLD, isNodeLeader() ? 0 : MPI_UNDEFINED, key, &m_leaderComm);
+
+        if (isNodeLeader())
+            MPI_Comm_rank(m_leaderComm, &m_leaderRank);
+        MPI_Bcast(&m_leaderRank, 1, MPI_INT, 0, m_nodeComm);
+    }
+
+    void freeWindow()
+    {
+        if (m_window != MPI_WIN_NULL)
+            MPI_Win_free(&m_window);
+
+        p_base = nullptr;
+    }
+
+private:
+    MPI_Comm m_nodeComm;
+    MPI_Comm m_leaderComm;
+    MPI_Win m_window;
+    int m_nodeRank;
+    int m_leaderRank;
+    int64_t m_rows;
+    int64_t m_cols;
+    T* p_base;
+};
+}  // namespace hpkmedoids
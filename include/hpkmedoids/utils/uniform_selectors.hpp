@@ -1,6 +1,7 @@
 #pragma once
 
-#include <set>
+#include <cstdint>
+#include <vector>
 
 namespace hpkmedoids
 {
@@ -11,18 +12,48 @@ public:
 
     virtual ~AbstractUniformSelector() = default;
 
-    virtual std::set<int32_t> select(const int sampleSize, const int32_t containerSize) const = 0;
+    virtual std::vector<int32_t> select(const int sampleSize, const int32_t containerSize) const = 0;
+
+    virtual std::vector<int32_t> select(const int sampleSize, const int32_t containerSize,
+                                        const uint64_t stream) const = 0;
+
+    int64_t getSeed() const;
+
+    void setSeed(const int64_t seed);
 
 protected:
     int64_t m_seed;
     int m_min;
 };
 
+// Selects sampleSize distinct indices in [min, containerSize) with Floyd's algorithm, which draws exactly sampleSize
+// random numbers, and returns them sorted so that rows are gathered in memory order. Sample sizes larger than the range
+// select the whole range. Selections come from counter-based
+// streams: the same seed and stream give the same selections on every thread and rank.
 class UniformSelector : public AbstractUniformSelector
 {
 public:
     UniformSelector(const int64_t* seed = nullptr, const int min = 0);
 
-    std::set<int32_t> select(const int sampleSize, const int32_t containerSize) const override;
+    // Draws from the next stream of this selector. Not safe to call concurrently on the same selector.
+    std::vector<int32_t> select(const int sampleSize, const int32_t containerSize) const override;
+
+    std::vector<int32_t> select(const int sampleSize, const int32_t containerSize,
+                                const uint64_t stream) const override;
+
+    // As the two above, but reuse the storage of selections.
+    void select(const int sampleSize, const int32_t containerSize, std::vector<int32_t>& selections) const;
+
+    void select(const int sampleSize, const int32_t containerSize, const uint64_t stream,
+                std::vector<int32_t>& selections) const;
+
+    // Above this sample size the selections are tracked in a bitmap instead of by sorted insertion.
+    static constexpr int SORTED_INSERT_LIMIT = 2048;
+
+    // The streams used by select without a stream argument start here so they never overlap explicit ones.
+    static constexpr uint64_t IMPLICIT_STREAMS_BEGIN = uint64_t(1) << 63;
+
+private:
+    mutable uint64_t m_nextStream;
 };
-}  // namespace hpkmedoids
\ No newline at end of file
+}  // namespace hpkmedoids
@@ -5,7 +5,9 @@
 #include <algorithm>
 #include <array>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <type_traits>
 
 namespace hpkmedoids
 {
@@ -35,9 +37,9 @@ ForwardIt min_element(ForwardIt first, ForwardIt last)
 }
 
 template <typename Iter>
-typename Iter::value_type getSecondLowest(Iter begin, Iter end)
+typename std::iterator_traits<Iter>::value_type getSecondLowest(Iter begin, Iter end)
 {
-    std::array<typename Iter::value_type, 2> temp;
+    std::array<typename std::iterator_traits<Iter>::value_type, 2> temp;
     std::partial_sort_copy(begin, end, temp.begin(), temp.end());
     return temp[1];
 }
@@ -49,4 +51,11 @@ MPI_Datatype matchMPIType()
     MPI_Type_match_size(MPI_TYPECLASS_REAL, sizeof(T), &dtype);
     return dtype;
 }
+
+// Datatype of a {T, int} pair for use with MPI_MINLOC and MPI_MAXLOC.
+template <typename T>
+MPI_Datatype matchMPIPairType()
+{
+    return std::is_same<T, float>::value ? MPI_FLOAT_INT : MPI_DOUBLE_INT;
+}
 }  // namespace hpkmedoids
\ No newline at end of file
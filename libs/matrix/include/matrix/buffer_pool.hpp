@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+// Memory resource that recycles buffers by size class. Requests are rounded up to the next power of two of at least
+// MIN_BLOCK_SIZE bytes and served from the free list of that class, falling back to the upstream resource when it is
+// empty. Deallocated buffers go back to their free list instead of upstream, so a loop that keeps allocating and
+// freeing buffers of the same sizes stops hitting the heap after its first iteration. Every block is returned
+// upstream when the pool is released or destroyed, which must therefore outlive the buffers taken from it. Not
+// thread safe.
+class BufferPool : public std::pmr::memory_resource
+{
+public:
+    explicit BufferPool(std::pmr::memory_resource* const upstream = std::pmr::get_default_resource());
+
+    BufferPool(const BufferPool&) = delete;
+
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    ~BufferPool() override;
+
+    // Returns every block to upstream, including those still handed out.
+    void release();
+
+    // Bytes currently held from upstream, whether handed out or cached.
+    int64_t reserved() const noexcept;
+
+    std::pmr::memory_resource* upstream() const noexcept;
+
+    static constexpr size_t MIN_BLOCK_SIZE = 64;
+
+    // Alignment of every block, so requests aligned to at most this much can share the free lists.
+    static constexpr size_t BLOCK_ALIGNMENT = 64;
+
+protected:
+    void* do_allocate(const size_t bytes, const size_t alignment) override;
+
+    void do_deallocate(void* const ptr, const size_t bytes, const size_t alignment) override;
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    static int sizeClass(const size_t bytes) noexcept;
+
+    static size_t blockSize(const int sizeClass) noexcept;
+
+private:
+    struct Block
+    {
+        void* ptr;
+        size_t bytes;
+        size_t alignment;
+    };
+
+    std::pmr::memory_resource* p_upstream;
+    std::vector<std::vector<void*>> m_freeLists;
+    std::vector<Block> m_blocks;
+    int64_t m_reserved;
+};
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <iterator>
+#include <memory_resource>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -8,128 +10,160 @@
     #include <assert.h>
 #endif
 
+// Row-major matrix whose storage is aligned to ALIGNMENT bytes. Rows are packed by default. With padRows every row
+// starts on an ALIGNMENT boundary: the leading dimension ld() is cols() rounded up to a whole number of ALIGNMENT
+// bytes and the padding is kept at zero. Row and column access and element-wise operations honor ld(). The whole
+// matrix iterators and data() expose the raw storage, which is only contiguous across rows when ld() == cols().
+// Matrices that are walked across many pages, such as N x N distance matrices, can opt into huge pages with
+// setAllocationPolicy, which applies from the next allocation. A matrix can also be bound to a memory resource, such
+// as a BufferPool, at construction and then takes all of its storage from it.
 template <typename T>
 class Matrix
 {
 public:
+    // Random access iterator over a column, stepping ld() elements at a time.
     template <bool Const = false>
-    class ForwardRowIterator
+    class ColumnIterator
     {
     public:
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
         using value_type        = std::remove_cv_t<T>;
         using difference_type   = std::ptrdiff_t;
         using pointer           = typename std::conditional_t<Const, const T*, T*>;
         using reference         = typename std::conditional_t<Const, const T&, T&>;
 
-        ForwardRowIterator() : p_iter(nullptr) {}
+        ColumnIterator() : p_iter(nullptr), m_ld(0) {}
 
-        ForwardRowIterator(pointer ptr) : p_iter(ptr) {}
+        ColumnIterator(pointer ptr, int64_t ld) : p_iter(ptr), m_ld(ld) {}
 
-        ForwardRowIterator operator++()
+        template <bool _Const = Const, typename = std::enable_if_t<_Const>>
+        ColumnIterator(const ColumnIterator<false>& other) : p_iter(other.base()), m_ld(other.ld())
         {
-            ForwardRowIterator temp = *this;
-            p_iter++;
-            return temp;
         }
 
-        ForwardRowIterator& operator++(int)
+        ColumnIterator& operator++()
         {
-            ++p_iter;
+            p_iter += m_ld;
             return *this;
         }
 
-        bool operator==(const ForwardRowIterator& rhs) const { return p_iter == rhs.p_iter; }
-
-        bool operator!=(const ForwardRowIterator& rhs) const { return p_iter != rhs.p_iter; }
-
-        template <bool _Const = Const>
-        std::enable_if_t<_Const, reference> operator*() const
+        ColumnIterator operator++(int)
         {
-            assert(p_iter != nullptr);
-            return *p_iter;
+            ColumnIterator temp = *this;
+            p_iter += m_ld;
+            return temp;
         }
 
-        template <bool _Const = Const>
-        std::enable_if_t<!_Const, reference> operator*()
+        ColumnIterator& operator--()
         {
-            assert(p_iter != nullptr);
-            return *p_iter;
+            p_iter -= m_ld;
+            return *this;
         }
 
-    private:
-        pointer p_iter;
-    };
-
-    template <bool Const = false>
-    class ForwardColumnIterator
-    {
-    public:
-        using iterator_category = std::forward_iterator_tag;
-        using value_type        = std::remove_cv_t<T>;
-        using difference_type   = std::ptrdiff_t;
-        using pointer           = typename std::conditional_t<Const, const T*, T*>;
-        using reference         = typename std::conditional_t<Const, const T&, T&>;
-
-        ForwardColumnIterator() : p_iter(nullptr), m_cols(0) {}
-
-        ForwardColumnIterator(pointer ptr, int64_t cols) : p_iter(ptr), m_cols(cols) {}
-
-        ForwardColumnIterator operator++()
+        ColumnIterator operator--(int)
         {
-            ForwardColumnIterator temp = *this;
-            p_iter += m_cols;
+            ColumnIterator temp = *this;
+            p_iter -= m_ld;
             return temp;
         }
 
-        ForwardColumnIterator& operator++(int)
+        ColumnIterator& operator+=(const difference_type n)
         {
-            p_iter += m_cols;
+            p_iter += n * m_ld;
             return *this;
         }
 
-        bool operator==(const ForwardColumnIterator& rhs) const { return p_iter == rhs.p_iter; }
-
-        bool operator!=(const ForwardColumnIterator& rhs) const { return p_iter != rhs.p_iter; }
-
-        template <bool _Const = Const>
-        std::enable_if_t<_Const, reference> operator*() const
+        ColumnIterator& operator-=(const difference_type n)
         {
-            assert(p_iter != nullptr);
-            return *p_iter;
+            p_iter -= n * m_ld;
+            return *this;
         }
 
-        template <bool _Const = Const>
-        std::enable_if_t<!_Const, reference> operator*()
+        ColumnIterator operator+(const difference_type n) const { return ColumnIterator(p_iter + n * m_ld, m_ld); }
+
+        friend ColumnIterator operator+(const difference_type n, const ColumnIterator& iter) { return iter + n; }
+
+        ColumnIterator operator-(const difference_type n) const { return ColumnIterator(p_iter - n * m_ld, m_ld); }
+
+        difference_type operator-(const ColumnIterator& rhs) const { return (p_iter - rhs.p_iter) / m_ld; }
+
+        bool operator==(const ColumnIterator& rhs) const { return p_iter == rhs.p_iter; }
+
+        bool operator!=(const ColumnIterator& rhs) const { return p_iter != rhs.p_iter; }
+
+        bool operator<(const ColumnIterator& rhs) const { return p_iter < rhs.p_iter; }
+
+        bool operator>(const ColumnIterator& rhs) const { return p_iter > rhs.p_iter; }
+
+        bool operator<=(const ColumnIterator& rhs) const { return p_iter <= rhs.p_iter; }
+
+        bool operator>=(const ColumnIterator& rhs) const { return p_iter >= rhs.p_iter; }
+
+        reference operator*() const
         {
             assert(p_iter != nullptr);
             return *p_iter;
         }
 
+        pointer operator->() const { return p_iter; }
+
+        reference operator[](const difference_type n) const { return *(p_iter + n * m_ld); }
+
+        pointer base() const { return p_iter; }
+
+        int64_t ld() const { return m_ld; }
+
     private:
         pointer p_iter;
-        int64_t m_cols;
+        int64_t m_ld;
     };
 
+    // Rows are contiguous, so they are iterated with plain pointers and the standard algorithms take their fastest
+    // paths over them.
     typedef T value_type;
-    typedef ForwardRowIterator<false> row_iterator;
-    typedef ForwardRowIterator<true> const_row_iterator;
-    typedef ForwardColumnIterator<false> col_iterator;
-    typedef ForwardColumnIterator<true> const_col_iterator;
+    typedef T* row_iterator;
+    typedef const T* const_row_iterator;
+    typedef ColumnIterator<false> col_iterator;
+    typedef ColumnIterator<true> const_col_iterator;
+
+    // HugePages maps allocations of at least HUGE_PAGE_SIZE bytes with mmap, aligned to HUGE_PAGE_SIZE and advised
+    // with MADV_HUGEPAGE, or backed by MAP_HUGETLB when built with MATRIX_USE_HUGETLB and huge pages are reserved.
+    // Smaller allocations are made as with Aligned. Ignored by matrices bound to a memory resource.
+    enum class AllocationPolicy
+    {
+        Aligned,
+        HugePages
+    };
 
     Matrix();
 
-    Matrix(const int64_t rows, const int64_t cols, const bool autoReserve = false, const T fillVal = 0.0);
+    Matrix(const int64_t rows, const int64_t cols, const bool autoReserve = false, const T fillVal = 0.0,
+           const bool padRows = false);
+
+    // Wraps rows * cols elements of existing memory without copying or taking ownership of it. The matrix is full.
+    Matrix(T* const data, const int64_t rows, const int64_t cols);
+
+    // As above, for rows * ld elements of which the first cols of every row belong to the matrix.
+    Matrix(T* const data, const int64_t rows, const int64_t cols, const int64_t ld);
+
+    // An empty matrix whose storage comes from resource, which must outlive it. Shaped with reshape.
+    explicit Matrix(std::pmr::memory_resource* const resource);
 
+    // Copies are allocated from the heap, whatever resource the source uses.
     Matrix(const Matrix& other);
 
-    Matrix(Matrix&& other);
+    // A full matrix whose contents, including any row padding, are left uninitialized, for consumers that write
+    // every element. Each page is then first touched by the thread that writes it.
+    static Matrix uninitialized(const int64_t rows, const int64_t cols, const bool padRows = false);
+
+    // Moves never allocate, so swapping matrices is free.
+    Matrix(Matrix&& other) noexcept;
 
     virtual ~Matrix();
 
     Matrix& operator=(const Matrix& rhs);
 
-    Matrix& operator=(Matrix&& rhs);
+    Matrix& operator=(Matrix&& rhs) noexcept;
 
     bool operator==(const Matrix& rhs) const;
 
@@ -140,7 +174,7 @@ public:
     {
         checkAtCapacity();
 
-        std::copy(datapoint.cbegin(), datapoint.cend(), p_data + m_size);
+        std::copy(datapoint.cbegin(), datapoint.cend(), p_data + m_numRows * m_ld);
         ++m_numRows;
         m_size += m_cols;
     }
@@ -150,7 +184,7 @@ public:
     {
         checkAtCapacity();
 
-        std::copy(datapoint.cbegin(), datapoint.cend(), p_data + m_size);
+        std::copy(datapoint.cbegin(), datapoint.cend(), p_data + m_numRows * m_ld);
         ++m_numRows;
         m_size += m_cols;
     }
@@ -160,7 +194,7 @@ public:
     {
         checkAtCapacity();
 
-        std::copy(begin, end, p_data + m_size);
+        std::copy(begin, end, p_data + m_numRows * m_ld);
         ++m_numRows;
         m_size += m_cols;
     }
@@ -185,6 +219,13 @@ public:
 
     void resize(const int64_t elements);
 
+    // Changes the dimensions and empties the matrix like the matching constructor, but keeps the current allocation
+    // when it is large enough. Rows stay padded if they were.
+    void reshape(const int64_t rows, const int64_t cols, const bool autoResize = false, const T fillVal = 0.0);
+
+    // As reshape followed by resize(rows), but the contents, including any row padding, are left uninitialized.
+    void reshapeUninitialized(const int64_t rows, const int64_t cols);
+
     void fill(const T val);
 
     void clear();
@@ -241,14 +282,39 @@ public:
 
     int64_t cols() const noexcept;
 
+    // Distance in elements between the starts of consecutive rows.
+    int64_t ld() const noexcept;
+
     int64_t size() const noexcept;
 
     int64_t capacity() const noexcept;
 
+    int64_t allocated() const noexcept;
+
+    // Size of the storage, including any row padding.
     int64_t bytes() const noexcept;
 
+    bool ownsData() const noexcept;
+
+    void setAllocationPolicy(const AllocationPolicy policy) noexcept;
+
+    AllocationPolicy allocationPolicy() const noexcept;
+
+    // The resource storage is taken from, nullptr for the heap.
+    std::pmr::memory_resource* memoryResource() const noexcept;
+
+    // Whether the current storage was mapped with mmap rather than allocated on the heap.
+    bool mapped() const noexcept;
+
     char* serialize() const noexcept;
 
+    static constexpr int64_t ALIGNMENT = 64;
+
+    static constexpr int64_t HUGE_PAGE_SIZE = 2 << 20;
+
+    // Leading dimension used for cols columns when padding rows.
+    static int64_t paddedCols(const int64_t cols) noexcept;
+
 protected:
     void checkAtCapacity();
 
@@ -261,11 +327,32 @@ private:
 
     void allocate(const bool autoSize, const T fillVal);
 
+    void setShape(const int64_t rows, const int64_t cols);
+
+    void reserveStorage();
+
+    void clearPadding();
+
+    void allocateStorage(const int64_t elements);
+
+    static int64_t roundToHugePages(const int64_t bytes) noexcept;
+
+    static T* mapStorage(const int64_t bytes);
+
+    void release() noexcept;
+
 protected:
     int64_t m_rows;
     int64_t m_cols;
     int64_t m_capacity;
     int64_t m_numRows;
     int64_t m_size;
+    int64_t m_allocated;
+    int64_t m_ld;
+    bool m_padRows;
+    bool m_ownsData;
+    AllocationPolicy m_policy;
+    bool m_mapped;
+    std::pmr::memory_resource* p_resource;
     T* p_data;
 };
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "matrix.hpp"
+
+// Read-only view of rows x cols elements of existing memory whose rows start ld elements apart, such as a buffer owned
+// by the caller, a mapped file or a block of rows or columns of a Matrix. Nothing is copied or owned, so the memory
+// must outlive the view. A Matrix converts to a view of its filled rows.
+template <typename T>
+class MatrixView
+{
+public:
+    typedef T value_type;
+    typedef const T* const_row_iterator;
+    typedef typename Matrix<T>::const_col_iterator const_col_iterator;
+
+    MatrixView() : p_data(nullptr), m_rows(0), m_cols(0), m_ld(0) {}
+
+    MatrixView(const T* const data, const int64_t rows, const int64_t cols) : MatrixView(data, rows, cols, cols) {}
+
+    MatrixView(const T* const data, const int64_t rows, const int64_t cols, const int64_t ld) :
+        p_data(data), m_rows(rows), m_cols(cols), m_ld(ld)
+    {
+        if (rows < 0 || cols < 0 || ld < cols)
+            throw std::length_error("Invalid matrix view of " + std::to_string(rows) + " x " + std::to_string(cols) +
+                                    " elements with leading dimension " + std::to_string(ld) + ".");
+    }
+
+    MatrixView(const Matrix<T>& matrix) :
+        p_data(matrix.data()), m_rows(matrix.numRows()), m_cols(matrix.cols()), m_ld(matrix.ld())
+    {
+    }
+
+    // The count rows starting at row begin.
+    MatrixView rowRange(const int64_t begin, const int64_t count) const
+    {
+        checkRange(begin, count, m_rows, "rows");
+        return MatrixView(p_data + begin * m_ld, count, m_cols, m_ld);
+    }
+
+    // The count columns starting at column begin of every row.
+    MatrixView colRange(const int64_t begin, const int64_t count) const
+    {
+        checkRange(begin, count, m_cols, "cols");
+        return MatrixView(p_data + begin, m_rows, count, m_ld);
+    }
+
+    const T* at(const int64_t row) const { return p_data + row * m_ld; }
+
+    const T& at(const int64_t row, const int64_t col) const { return p_data[row * m_ld + col]; }
+
+    const_row_iterator crowBegin(const int64_t row) const { return at(row); }
+
+    const_row_iterator crowEnd(const int64_t row) const { return at(row) + m_cols; }
+
+    const_col_iterator ccolBegin(const int64_t col) const { return const_col_iterator(p_data + col, m_ld); }
+
+    const_col_iterator ccolEnd(const int64_t col) const
+    {
+        return const_col_iterator(p_data + col + m_rows * m_ld, m_ld);
+    }
+
+    const T* data() const noexcept { return p_data; }
+
+    int64_t rows() const noexcept { return m_rows; }
+
+    int64_t numRows() const noexcept { return m_rows; }
+
+    int64_t cols() const noexcept { return m_cols; }
+
+    int64_t ld() const noexcept { return m_ld; }
+
+    bool empty() const noexcept { return m_rows == 0 || m_cols == 0; }
+
+private:
+    static void checkRange(const int64_t begin, const int64_t count, const int64_t size, const char* const dim)
+    {
+        if (begin < 0 || count < 0 || begin + count > size)
+            throw std::out_of_range("Range [" + std::to_string(begin) + ", " + std::to_string(begin + count) +
+                                    ") is outside of the " + std::to_string(size) + " " + dim + " of the view.");
+    }
+
+private:
+    const T* p_data;
+    int64_t m_rows;
+    int64_t m_cols;
+    int64_t m_ld;
+};
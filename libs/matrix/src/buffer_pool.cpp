@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <buffer_pool.hpp>
+
+BufferPool::BufferPool(std::pmr::memory_resource* const upstream) : p_upstream(upstream), m_reserved(0)
+{
+}
+
+BufferPool::~BufferPool()
+{
+    release();
+}
+
+void BufferPool::release()
+{
+    for (const auto& block : m_blocks)
+    {
+        p_upstream->deallocate(block.ptr, block.bytes, block.alignment);
+    }
+
+    m_blocks.clear();
+    m_freeLists.clear();
+    m_reserved = 0;
+}
+
+int64_t BufferPool::reserved() const noexcept
+{
+    return m_reserved;
+}
+
+std::pmr::memory_resource* BufferPool::upstream() const noexcept
+{
+    return p_upstream;
+}
+
+// Over-aligned requests are not pooled and go straight to upstream.
+void* BufferPool::do_allocate(const size_t bytes, const size_t alignment)
+{
+    if (alignment > BLOCK_ALIGNMENT)
+    {
+        auto ptr = p_upstream->allocate(bytes, alignment);
+        m_blocks.push_back({ ptr, bytes, alignment });
+        m_reserved += bytes;
+        return ptr;
+    }
+
+    auto cls = sizeClass(bytes);
+    if (cls < static_cast<int>(m_freeLists.size()) && !m_freeLists[cls].empty())
+    {
+        auto ptr = m_freeLists[cls].back();
+        m_freeLists[cls].pop_back();
+        return ptr;
+    }
+
+    auto ptr = p_upstream->allocate(blockSize(cls), BLOCK_ALIGNMENT);
+    m_blocks.push_back({ ptr, blockSize(cls), BLOCK_ALIGNMENT });
+    m_reserved += blockSize(cls);
+    return ptr;
+}
+
+void BufferPool::do_deallocate(void* const ptr, const size_t bytes, const size_t alignment)
+{
+    if (alignment > BLOCK_ALIGNMENT)
+    {
+        auto block = std::find_if(m_blocks.begin(), m_blocks.end(), [ptr](const Block& b) { return b.ptr == ptr; });
+        m_reserved -= block->bytes;
+        m_blocks.erase(block);
+        p_upstream->deallocate(ptr, bytes, alignment);
+        return;
+    }
+
+    auto cls = sizeClass(bytes);
+    if (cls >= static_cast<int>(m_freeLists.size()))
+        m_freeLists.resize(cls + 1);
+
+    m_freeLists[cls].push_back(ptr);
+}
+
+bool BufferPool::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+int BufferPool::sizeClass(const size_t bytes) noexcept
+{
+    int cls = 0;
+    while (blockSize(cls) < bytes)
+    {
+        ++cls;
+    }
+
+    return cls;
+}
+
+size_t BufferPool::blockSize(const int sizeClass) noexcept
+{
+    return MIN_BLOCK_SIZE << sizeClass;
+}
@@ -1,21 +1,83 @@
+#include <sys/mman.h>
+
 #include <exception>
 #include <matrix.hpp>
+#include <new>
 #include <string>
 #ifndef __clang__
     #include <algorithm>
 #endif
 
 template <typename T>
-Matrix<T>::Matrix() : m_rows(0), m_cols(0), m_capacity(0), m_numRows(0), m_size(0), p_data(nullptr)
+Matrix<T>::Matrix() :
+    m_rows(0),
+    m_cols(0),
+    m_capacity(0),
+    m_numRows(0),
+    m_size(0),
+    m_allocated(0),
+    m_ld(0),
+    m_padRows(false),
+    m_ownsData(true),
+    m_policy(AllocationPolicy::Aligned),
+    m_mapped(false),
+    p_resource(nullptr),
+    p_data(nullptr)
+{
+}
+
+template <typename T>
+Matrix<T>::Matrix(const int64_t rows, const int64_t cols, const bool autoResize, const T fillVal,
+                  const bool padRows) :
+    m_rows(rows),
+    m_cols(cols),
+    m_capacity(rows * cols),
+    m_numRows(0),
+    m_size(0),
+    m_allocated(0),
+    m_ld(padRows ? paddedCols(cols) : cols),
+    m_padRows(padRows),
+    m_ownsData(true),
+    m_policy(AllocationPolicy::Aligned),
+    m_mapped(false),
+    p_resource(nullptr),
+    p_data(nullptr)
+{
+    validateDimensions();
+    allocate(autoResize, fillVal);
+}
+
+template <typename T>
+Matrix<T>::Matrix(T* const data, const int64_t rows, const int64_t cols) : Matrix(data, rows, cols, cols)
 {
 }
 
 template <typename T>
-Matrix<T>::Matrix(const int64_t rows, const int64_t cols, const bool autoResize, const T fillVal) :
-    m_rows(rows), m_cols(cols), m_capacity(rows * cols), m_numRows(0), m_size(0), p_data(nullptr)
+Matrix<T>::Matrix(T* const data, const int64_t rows, const int64_t cols, const int64_t ld) :
+    m_rows(rows),
+    m_cols(cols),
+    m_capacity(rows * cols),
+    m_numRows(rows),
+    m_size(rows * cols),
+    m_allocated(rows * ld),
+    m_ld(ld),
+    m_padRows(false),
+    m_ownsData(false),
+    m_policy(AllocationPolicy::Aligned),
+    m_mapped(false),
+    p_resource(nullptr),
+    p_data(data)
 {
     validateDimensions();
-    allocate(autoResize, fillVal);
+    if (ld < cols)
+        throw std::length_error("The leading dimension of a matrix must be at least its number of cols. Provided: " +
+                                std::to_string(ld));
+}
+
+template <typename T>
+Matrix<T>::Matrix(std::pmr::memory_resource* const resource) : Matrix()
+{
+    p_resource = resource;
 }
 
 template <typename T>
@@ -25,13 +87,30 @@ Matrix<T>::Matrix(const Matrix<T>& other) :
     m_capacity(other.m_capacity),
     m_numRows(other.m_numRows),
     m_size(other.m_size),
-    p_data(new T[m_capacity])
+    m_allocated(0),
+    m_ld(other.m_ld),
+    m_padRows(other.m_padRows),
+    m_ownsData(true),
+    m_policy(other.m_policy),
+    m_mapped(false),
+    p_resource(nullptr),
+    p_data(nullptr)
 {
-    std::copy(other.cbegin(), other.cend(), begin());
+    allocateStorage(m_rows * m_ld);
+    std::copy(other.p_data, other.p_data + m_allocated, p_data);
 }
 
 template <typename T>
-Matrix<T>::Matrix(Matrix<T>&& other) : Matrix(0, 0, false)
+Matrix<T> Matrix<T>::uninitialized(const int64_t rows, const int64_t cols, const bool padRows)
+{
+    Matrix<T> matrix;
+    matrix.m_padRows = padRows;
+    matrix.reshapeUninitialized(rows, cols);
+    return matrix;
+}
+
+template <typename T>
+Matrix<T>::Matrix(Matrix<T>&& other) noexcept : Matrix()
 {
     *this = std::move(other);
 }
@@ -39,11 +118,7 @@ Matrix<T>::Matrix(Matrix<T>&& other) : Matrix(0, 0, false)
 template <typename T>
 Matrix<T>::~Matrix()
 {
-    if (p_data != nullptr)
-    {
-        delete[] p_data;
-        p_data = nullptr;
-    }
+    release();
 }
 
 template <typename T>
@@ -51,42 +126,60 @@ Matrix<T>& Matrix<T>::operator=(const Matrix<T>& rhs)
 {
     if (this != &rhs)
     {
-        if (p_data != nullptr)
-            delete[] p_data;
+        auto storage = rhs.m_rows * rhs.m_ld;
+        if (!m_ownsData || storage > m_allocated)
+        {
+            release();
+            allocateStorage(storage);
+        }
 
         m_rows     = rhs.m_rows;
         m_cols     = rhs.m_cols;
         m_capacity = rhs.m_capacity;
         m_numRows  = rhs.m_numRows;
         m_size     = rhs.m_size;
-        p_data     = new T[m_capacity];
-        std::copy(rhs.cbegin(), rhs.cend(), begin());
+        m_ld       = rhs.m_ld;
+        m_padRows  = rhs.m_padRows;
+        std::copy(rhs.p_data, rhs.p_data + storage, p_data);
     }
 
     return *this;
 }
 
 template <typename T>
-Matrix<T>& Matrix<T>::operator=(Matrix<T>&& rhs)
+Matrix<T>& Matrix<T>::operator=(Matrix<T>&& rhs) noexcept
 {
     if (this != &rhs)
     {
-        if (p_data != nullptr)
-            delete[] p_data;
-
-        m_rows     = rhs.m_rows;
-        m_cols     = rhs.m_cols;
-        m_capacity = rhs.m_capacity;
-        m_numRows  = rhs.m_numRows;
-        m_size     = rhs.m_size;
-        p_data     = rhs.p_data;
-
-        rhs.m_rows     = 0;
-        rhs.m_cols     = 0;
-        rhs.m_capacity = 0;
-        rhs.m_numRows  = 0;
-        rhs.m_size     = 0;
-        rhs.p_data     = nullptr;
+        release();
+
+        m_rows      = rhs.m_rows;
+        m_cols      = rhs.m_cols;
+        m_capacity  = rhs.m_capacity;
+        m_numRows   = rhs.m_numRows;
+        m_size      = rhs.m_size;
+        m_allocated = rhs.m_allocated;
+        m_ld        = rhs.m_ld;
+        m_padRows   = rhs.m_padRows;
+        m_ownsData  = rhs.m_ownsData;
+        m_policy    = rhs.m_policy;
+        m_mapped    = rhs.m_mapped;
+        p_resource  = rhs.p_resource;
+        p_data      = rhs.p_data;
+
+        rhs.m_rows      = 0;
+        rhs.m_cols      = 0;
+        rhs.m_capacity  = 0;
+        rhs.m_numRows   = 0;
+        rhs.m_size      = 0;
+        rhs.m_allocated = 0;
+        rhs.m_ld        = 0;
+        rhs.m_padRows   = false;
+        rhs.m_ownsData  = true;
+        rhs.m_policy    = AllocationPolicy::Aligned;
+        rhs.m_mapped    = false;
+        rhs.p_resource  = nullptr;
+        rhs.p_data      = nullptr;
     }
 
     return *this;
@@ -110,9 +203,9 @@ bool Matrix<T>::operator==(const Matrix<T>& rhs) const
     if (m_size != rhs.m_size)
         return false;
 
-    for (int64_t i = 0; i < size(); ++i)
+    for (int64_t i = 0; i < m_numRows; ++i)
     {
-        if (p_data[i] != rhs.p_data[i])
+        if (!std::equal(crowBegin(i), crowEnd(i), rhs.crowBegin(i)))
             return false;
     }
 
@@ -135,10 +228,39 @@ void Matrix<T>::resize(const int64_t rows)
     m_size    = rows * m_cols;
 }
 
+template <typename T>
+void Matrix<T>::reshape(const int64_t rows, const int64_t cols, const bool autoResize, const T fillVal)
+{
+    setShape(rows, cols);
+    reserveStorage();
+    clearPadding();
+    if (autoResize)
+    {
+        resize(m_rows);
+        fill(fillVal);
+    }
+}
+
+template <typename T>
+void Matrix<T>::reshapeUninitialized(const int64_t rows, const int64_t cols)
+{
+    setShape(rows, cols);
+    reserveStorage();
+    resize(m_rows);
+}
+
 template <typename T>
 void Matrix<T>::fill(const T val)
 {
-    std::fill(begin(), end(), val);
+    if (m_ld == m_cols)
+        std::fill(p_data, p_data + m_capacity, val);
+    else
+    {
+        for (int64_t i = 0; i < m_rows; ++i)
+        {
+            std::fill(rowBegin(i), rowEnd(i), val);
+        }
+    }
 }
 
 template <typename T>
@@ -175,7 +297,7 @@ const T* Matrix<T>::at(const int64_t row) const
         throw std::out_of_range("Row index " + std::to_string(row) + " out of range [0, " + std::to_string(m_rows - 1) +
                                 "].");
 
-    return p_data + (row * m_cols);
+    return p_data + (row * m_ld);
 }
 
 template <typename T>
@@ -193,7 +315,7 @@ const T& Matrix<T>::at(const int64_t row, const int64_t col) const
 template <typename T>
 const T* Matrix<T>::at(const int64_t row) const
 {
-    return p_data + (row * m_cols);
+    return p_data + (row * m_ld);
 }
 
 template <typename T>
@@ -207,9 +329,15 @@ const T& Matrix<T>::at(const int64_t row, const int64_t col) const
 template <typename T>
 std::pair<int32_t, int32_t> Matrix<T>::find(const T element) const
 {
-    auto iter     = std::find(cbegin(), cend(), element);
-    auto distance = std::distance(cbegin(), iter);
-    return std::make_pair<int32_t, int32_t>(distance / m_cols, distance % m_cols);  // row, col
+    for (int64_t i = 0; i < m_rows; ++i)
+    {
+        auto begin = at(i);
+        auto iter  = std::find(begin, begin + m_cols, element);
+        if (iter != begin + m_cols)
+            return std::make_pair<int32_t, int32_t>(i, iter - begin);  // row, col
+    }
+
+    return std::make_pair<int32_t, int32_t>(m_rows, 0);
 }
 
 template <typename T>
@@ -233,7 +361,7 @@ typename Matrix<T>::const_row_iterator Matrix<T>::cbegin() const
 template <typename T>
 typename Matrix<T>::col_iterator Matrix<T>::colBegin(const int64_t col)
 {
-    return Matrix<T>::col_iterator(p_data + col, m_cols);
+    return Matrix<T>::col_iterator(p_data + col, m_ld);
 }
 
 template <typename T>
@@ -251,25 +379,25 @@ typename Matrix<T>::const_row_iterator Matrix<T>::crowBegin(const int64_t row) c
 template <typename T>
 typename Matrix<T>::const_col_iterator Matrix<T>::ccolBegin(const int64_t col) const
 {
-    return Matrix<T>::const_col_iterator(p_data + col, m_cols);
+    return Matrix<T>::const_col_iterator(p_data + col, m_ld);
 }
 
 template <typename T>
 typename Matrix<T>::row_iterator Matrix<T>::end()
 {
-    return Matrix<T>::row_iterator(p_data + capacity());
+    return Matrix<T>::row_iterator(p_data + m_rows * m_ld);
 }
 
 template <typename T>
 typename Matrix<T>::const_row_iterator Matrix<T>::end() const
 {
-    return Matrix<T>::const_row_iterator(p_data + capacity());
+    return Matrix<T>::const_row_iterator(p_data + m_rows * m_ld);
 }
 
 template <typename T>
 typename Matrix<T>::const_row_iterator Matrix<T>::cend() const
 {
-    return Matrix<T>::const_row_iterator(p_data + capacity());
+    return Matrix<T>::const_row_iterator(p_data + m_rows * m_ld);
 }
 
 template <typename T>
@@ -281,7 +409,7 @@ typename Matrix<T>::row_iterator Matrix<T>::rowEnd(const int64_t row)
 template <typename T>
 typename Matrix<T>::col_iterator Matrix<T>::colEnd(const int64_t col)
 {
-    return Matrix<T>::col_iterator(p_data + col + (m_numRows * m_cols), m_cols);
+    return Matrix<T>::col_iterator(p_data + col + (m_numRows * m_ld), m_ld);
 }
 
 template <typename T>
@@ -293,7 +421,7 @@ typename Matrix<T>::const_row_iterator Matrix<T>::crowEnd(const int64_t row) con
 template <typename T>
 typename Matrix<T>::const_col_iterator Matrix<T>::ccolEnd(const int64_t col) const
 {
-    return Matrix<T>::const_col_iterator(p_data + col + (m_numRows * m_cols), m_cols);
+    return Matrix<T>::const_col_iterator(p_data + col + (m_numRows * m_ld), m_ld);
 }
 
 template <typename T>
@@ -332,6 +460,12 @@ int64_t Matrix<T>::cols() const noexcept
     return m_cols;
 }
 
+template <typename T>
+int64_t Matrix<T>::ld() const noexcept
+{
+    return m_ld;
+}
+
 template <typename T>
 int64_t Matrix<T>::size() const noexcept
 {
@@ -347,7 +481,43 @@ int64_t Matrix<T>::capacity() const noexcept
 template <typename T>
 int64_t Matrix<T>::bytes() const noexcept
 {
-    return m_capacity * static_cast<int64_t>(sizeof(T));
+    return m_rows * m_ld * static_cast<int64_t>(sizeof(T));
+}
+
+template <typename T>
+int64_t Matrix<T>::allocated() const noexcept
+{
+    return m_allocated;
+}
+
+template <typename T>
+bool Matrix<T>::ownsData() const noexcept
+{
+    return m_ownsData;
+}
+
+template <typename T>
+void Matrix<T>::setAllocationPolicy(const AllocationPolicy policy) noexcept
+{
+    m_policy = policy;
+}
+
+template <typename T>
+typename Matrix<T>::AllocationPolicy Matrix<T>::allocationPolicy() const noexcept
+{
+    return m_policy;
+}
+
+template <typename T>
+std::pmr::memory_resource* Matrix<T>::memoryResource() const noexcept
+{
+    return p_resource;
+}
+
+template <typename T>
+bool Matrix<T>::mapped() const noexcept
+{
+    return m_mapped;
 }
 
 template <typename T>
@@ -356,6 +526,13 @@ char* Matrix<T>::serialize() const noexcept
     return reinterpret_cast<char*>(p_data);
 }
 
+template <typename T>
+int64_t Matrix<T>::paddedCols(const int64_t cols) noexcept
+{
+    const int64_t colsPerBlock = ALIGNMENT / static_cast<int64_t>(sizeof(T));
+    return (cols + colsPerBlock - 1) / colsPerBlock * colsPerBlock;
+}
+
 template <typename T>
 void Matrix<T>::validateDimensions() const
 {
@@ -382,7 +559,8 @@ void Matrix<T>::validateCols() const
 template <typename T>
 void Matrix<T>::allocate(const bool autoresize, const T fillVal)
 {
-    p_data = new T[m_capacity];
+    allocateStorage(m_rows * m_ld);
+    clearPadding();
     if (autoresize)
     {
         resize(m_rows);
@@ -390,6 +568,110 @@ void Matrix<T>::allocate(const bool autoresize, const T fillVal)
     }
 }
 
+template <typename T>
+void Matrix<T>::setShape(const int64_t rows, const int64_t cols)
+{
+    m_rows = rows;
+    m_cols = cols;
+    validateDimensions();
+
+    m_capacity = rows * cols;
+    m_numRows  = 0;
+    m_size     = 0;
+    m_ld       = m_padRows ? paddedCols(cols) : cols;
+}
+
+template <typename T>
+void Matrix<T>::reserveStorage()
+{
+    if (m_rows * m_ld <= m_allocated)
+        return;
+
+    if (!m_ownsData)
+        throw std::length_error("Cannot grow a matrix that does not own its data.");
+
+    release();
+    allocateStorage(m_rows * m_ld);
+}
+
+template <typename T>
+void Matrix<T>::clearPadding()
+{
+    if (m_ld == m_cols)
+        return;
+
+    for (int64_t i = 0; i < m_rows; ++i)
+    {
+        std::fill(p_data + i * m_ld + m_cols, p_data + (i + 1) * m_ld, static_cast<T>(0));
+    }
+}
+
+template <typename T>
+void Matrix<T>::allocateStorage(const int64_t elements)
+{
+    auto bytes  = elements * static_cast<int64_t>(sizeof(T));
+    m_mapped    = !p_resource && m_policy == AllocationPolicy::HugePages && bytes >= HUGE_PAGE_SIZE;
+    m_allocated = elements;
+    m_ownsData  = true;
+    if (p_resource)
+        p_data = static_cast<T*>(p_resource->allocate(bytes, ALIGNMENT));
+    else if (m_mapped)
+        p_data = mapStorage(bytes);
+    else
+        p_data = static_cast<T*>(::operator new[](bytes, std::align_val_t(ALIGNMENT)));
+}
+
+template <typename T>
+int64_t Matrix<T>::roundToHugePages(const int64_t bytes) noexcept
+{
+    return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
+
+// Anonymous mappings are only page aligned, so one extra huge page is mapped and the unaligned head and tail are
+// unmapped again. The kernel can then back the range with whole huge pages.
+template <typename T>
+T* Matrix<T>::mapStorage(const int64_t bytes)
+{
+    auto length = static_cast<size_t>(roundToHugePages(bytes));
+#ifdef MATRIX_USE_HUGETLB
+    void* hugetlb = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (hugetlb != MAP_FAILED)
+        return static_cast<T*>(hugetlb);
+#endif
+
+    void* mapping = mmap(nullptr, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+        throw std::bad_alloc();
+
+    auto base    = reinterpret_cast<uintptr_t>(mapping);
+    auto aligned = (base + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    if (aligned != base)
+        munmap(mapping, aligned - base);
+    munmap(reinterpret_cast<void*>(aligned + length), base + HUGE_PAGE_SIZE - aligned);
+
+#ifdef MADV_HUGEPAGE
+    madvise(reinterpret_cast<void*>(aligned), length, MADV_HUGEPAGE);
+#endif
+    return reinterpret_cast<T*>(aligned);
+}
+
+template <typename T>
+void Matrix<T>::release() noexcept
+{
+    if (p_data != nullptr && m_ownsData)
+    {
+        if (p_resource)
+            p_resource->deallocate(p_data, m_allocated * sizeof(T), ALIGNMENT);
+        else if (m_mapped)
+            munmap(p_data, roundToHugePages(m_allocated * static_cast<int64_t>(sizeof(T))));
+        else
+            ::operator delete[](p_data, std::align_val_t(ALIGNMENT));
+    }
+
+    m_mapped = false;
+    p_data   = nullptr;
+}
+
 template <typename T>
 void Matrix<T>::checkAtCapacity()
 {
@@ -0,0 +1,35 @@
+#include <hpkmedoids/filesystem/dataset.hpp>
+#include <iostream>
+#include <string>
+
+using namespace hpkmedoids;
+
+// Converts a raw binary dataset into the dataset format, see DatasetHeader.
+int main(int argc, char* argv[])
+{
+    if (argc < 5)
+    {
+        std::cerr << "Usage: " << argv[0] << " <raw file> <dataset file> <rows> <cols> [float|double] [--pad]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::string rawPath     = argv[1];
+    std::string datasetPath = argv[2];
+    auto rows               = std::stoll(argv[3]);
+    auto cols               = std::stoll(argv[4]);
+    std::string type        = argc > 5 ? argv[5] : "double";
+    bool padRows            = argc > 6 && std::string(argv[6]) == "--pad";
+
+    if (type == "float")
+        convertRawDataset<float>(rawPath, datasetPath, rows, cols, DatasetWriter<float>(padRows));
+    else if (type == "double")
+        convertRawDataset<double>(rawPath, datasetPath, rows, cols, DatasetWriter<double>(padRows));
+    else
+    {
+        std::cerr << "Unknown element type: " << type << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <cstring>
+#include <hpkmedoids/filesystem/dataset.hpp>
+
+namespace hpkmedoids
+{
+int64_t dtypeSize(const DType dtype)
+{
+    switch (dtype)
+    {
+        case DType::Float32:
+            return sizeof(float);
+        case DType::Float64:
+            return sizeof(double);
+        default:
+            return 0;
+    }
+}
+
+int64_t DatasetHeader::payloadOffset() const
+{
+    auto size = static_cast<int64_t>(sizeof(DatasetHeader));
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+int64_t DatasetHeader::payloadBytes() const { return rows * stride * dtypeSize(dtype); }
+
+bool DatasetHeader::hasChecksum() const { return flags & HAS_CHECKSUM; }
+
+HeaderStatus checkDatasetHeader(const std::string& filepath, DatasetHeader* const header)
+{
+    std::ifstream file(filepath, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << "Unable to open file: " << filepath << std::endl;
+        return HeaderStatus::Invalid;
+    }
+
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(DatasetHeader)) ||
+        std::memcmp(header->magic, DatasetHeader::MAGIC, sizeof(header->magic)) != 0)
+        return HeaderStatus::Raw;
+
+    if (header->version != DatasetHeader::VERSION || dtypeSize(header->dtype) == 0 || header->rows < 0 ||
+        header->cols < 0 || header->stride < header->cols || header->alignment <= 0)
+    {
+        std::cerr << "Unsupported dataset header in file: " << filepath << std::endl;
+        return HeaderStatus::Invalid;
+    }
+
+    file.seekg(0, std::ios::end);
+    if (static_cast<int64_t>(file.tellg()) < header->payloadOffset() + header->payloadBytes())
+    {
+        std::cerr << "Dataset file is truncated: " << filepath << std::endl;
+        return HeaderStatus::Invalid;
+    }
+
+    return HeaderStatus::Dataset;
+}
+
+bool readDatasetHeader(const std::string& filepath, DatasetHeader* const header)
+{
+    auto status = checkDatasetHeader(filepath, header);
+    if (status == HeaderStatus::Invalid)
+        exit(1);
+
+    return status == HeaderStatus::Dataset;
+}
+
+uint64_t datasetChecksum(const char* const bytes, const int64_t size, const uint64_t hash)
+{
+    uint64_t result = hash;
+    for (int64_t i = 0; i < size; ++i)
+    {
+        result ^= static_cast<unsigned char>(bytes[i]);
+        result *= 1099511628211ull;
+    }
+
+    return result;
+}
+}  // namespace hpkmedoids
@@ -0,0 +1,32 @@
+#include <hpkmedoids/filesystem/disk_rows.hpp>
+
+namespace hpkmedoids
+{
+std::vector<RowRange> coalesceRows(const std::vector<std::pair<int32_t, int32_t>>& sortedRows, const int64_t rowBytes,
+                                   const int64_t maxGapBytes, const int64_t maxRangeBytes)
+{
+    std::vector<RowRange> ranges;
+    auto maxGapRows   = maxGapBytes / rowBytes;
+    auto maxRangeRows = std::max<int64_t>(1, maxRangeBytes / rowBytes);
+
+    for (int32_t i = 0; i < static_cast<int32_t>(sortedRows.size()); ++i)
+    {
+        int64_t row = sortedRows[i].first;
+        if (!ranges.empty())
+        {
+            auto& range = ranges.back();
+            auto end    = range.firstRow + range.numRows;
+            if (row < end + maxGapRows + 1 && row - range.firstRow < maxRangeRows)
+            {
+                range.numRows = std::max(end, row + 1) - range.firstRow;
+                range.end     = i + 1;
+                continue;
+            }
+        }
+
+        ranges.push_back({ row, 1, i, i + 1 });
+    }
+
+    return ranges;
+}
+}  // namespace hpkmedoids
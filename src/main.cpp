@@ -1,4 +1,6 @@
 #include <boost/timer/timer.hpp>
+#include <hpkmedoids/filesystem/disk_rows.hpp>
+#include <hpkmedoids/filesystem/mmap_reader.hpp>
 #include <hpkmedoids/filesystem/reader.hpp>
 #include <hpkmedoids/filesystem/writer.hpp>
 #include <hpkmedoids/kmedoids.hpp>
@@ -34,7 +36,8 @@ constexpr int repeats             = 1;
 constexpr int claraRepeats        = 10;
 int64_t runTime;
 
-const Clusters<value_t>* calcClusters(KMedoids<value_t, parallelism>* kmedoids, const Matrix<value_t>* const data)
+template <class KMedoidsType, class Data>
+const Clusters<value_t>* calcClusters(KMedoidsType* kmedoids, const Data* const data)
 {
     const Clusters<value_t>* results;
     for (int i = 0; i < numIters; ++i)
@@ -48,7 +51,8 @@ const Clusters<value_t>* calcClusters(KMedoids<value_t, parallelism>* kmedoids,
     return results;
 }
 
-const Clusters<value_t>* calcClusters(CLARAKMedoids<value_t, parallelism>* kmedoids, const Matrix<value_t>* const data)
+template <class Data>
+const Clusters<value_t>* calcClusters(CLARAKMedoids<value_t, parallelism>* kmedoids, const Data* const data)
 {
     const Clusters<value_t>* results;
     for (int i = 0; i < numIters; ++i)
@@ -62,39 +66,75 @@ const Clusters<value_t>* calcClusters(CLARAKMedoids<value_t, parallelism>* kmedo
     return results;
 }
 
+// Every rank passes the block of rows it read, see fitSlices.
+template <class KMedoidsType>
+const Clusters<value_t>* calcClusters(KMedoidsType* kmedoids, const Matrix<value_t>* const localData,
+                                      const int64_t numRows)
+{
+    const Clusters<value_t>* results;
+    for (int i = 0; i < numIters; ++i)
+    {
+        kmedoids->reset();
+        boost::timer::auto_cpu_timer t;
+        if constexpr (std::is_same_v<KMedoidsType, CLARAKMedoids<value_t, parallelism>>)
+            results = kmedoids->fitSlices(localData, numRows, numClusters, repeats, claraRepeats);
+        else
+            results = kmedoids->fitSlices(localData, numRows, numClusters, repeats);
+        runTime += t.elapsed().wall;
+    }
+
+    return results;
+}
+
+// PAM walks the whole dataset, so it is mapped. CLARA only reads the rows it samples and streams over the rest, so
+// the dataset never has to fit in memory.
+template <class KMedoidsType>
 void sharedMemory(std::string& filepath)
 {
-    MatrixReader<value_t> reader;
+    MmapMatrixReader<value_t> reader(AccessPattern::Sequential);
     ClusterResultWriter<value_t> writer(parallelism);
-    std::conditional<strings_equal(kmedoidsMethod, "REG"), KMedoids<value_t, parallelism>,
-                     CLARAKMedoids<value_t, parallelism>>::type kmedoids(PAM_INIT, PAM);
+    KMedoidsType kmedoids(PAM_INIT, PAM);
     const Clusters<value_t>* results;
 
-    auto data = reader.read(filepath, numData, dims);
-
-    results = calcClusters(&kmedoids, &data);
+    DatasetHeader header;
+    auto hasHeader = readDatasetHeader(filepath, &header);
+    if constexpr (std::is_same_v<KMedoidsType, KMedoids<value_t, parallelism>>)
+    {
+        DataView<value_t> data(hasHeader ? reader.readDataset(filepath) : reader.read(filepath, numData, dims));
+        results = calcClusters(&kmedoids, &data);
+    }
+    else
+    {
+        auto data = hasHeader ? DiskRows<value_t>(filepath) : DiskRows<value_t>(filepath, numData, dims);
+        results   = calcClusters(&kmedoids, &data);
+    }
 
     std::cout << "Error: " << results->getError() << "\n";
     writer.writeClusterResults(results, runTime, filepath);
 }
 
+template <class KMedoidsType>
 void distributed(std::string& filepath)
 {
     int rank;
     MPI_Init(nullptr, nullptr);
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-    MatrixReader<value_t> reader;
+    MPIMatrixReader<value_t> reader;
     ClusterResultWriter<value_t> writer(parallelism);
-    std::conditional<strings_equal(kmedoidsMethod, "REG"), KMedoids<value_t, parallelism>,
-                     CLARAKMedoids<value_t, parallelism>>::type kmedoids(PAM_INIT, PAM);
+    KMedoidsType kmedoids(PAM_INIT, PAM);
     const Clusters<value_t>* results;
 
-    Matrix<value_t> data;
-    if (rank == 0)
-        data = reader.read(filepath, numData, dims);
+    // Ranks read their blocks in parallel and keep them; the fits assemble the dataset from the blocks where needed.
+    DatasetHeader header;
+    auto status = checkDatasetHeader(filepath, &header);
+    if (status == HeaderStatus::Invalid)
+        MPI_Abort(MPI_COMM_WORLD, 1);
+
+    auto isDataset = status == HeaderStatus::Dataset;
+    auto localData = isDataset ? reader.readDatasetSlice(filepath) : reader.readSlice(filepath, numData, dims);
 
-    results = calcClusters(&kmedoids, &data);
+    results = calcClusters(&kmedoids, &localData, isDataset ? header.rows : numData);
 
     if (rank == 0)
     {
@@ -107,13 +147,17 @@ void distributed(std::string& filepath)
 
 int main(int argc, char* argv[])
 {
-    std::string filepath = /* INSERT PATH HERE */ std::to_string(numData) + "_" + std::to_string(dims) + "_" +
-                           std::to_string(numClusters) + ".txt";
+    // Files in the dataset format carry their own shape, raw files are expected to hold numData x dims elements.
+    std::string filepath = argc > 1 ? argv[1]
+                                    : /* INSERT PATH HERE */ std::to_string(numData) + "_" + std::to_string(dims) +
+                                          "_" + std::to_string(numClusters) + ".txt";
 
     std::cout << "Method: " << kmedoidsMethod << "\nParallelism: " << parallelismToString(parallelism)
               << "\nData: " << filepath << '\n';
-    if (parallelism == Parallelism::Serial || parallelism == Parallelism::OMP)
-        sharedMemory(filepath);
+    if constexpr (parallelism == Parallelism::Serial || parallelism == Parallelism::OMP)
+        sharedMemory<std::conditional<strings_equal(kmedoidsMethod, "REG"), KMedoids<value_t, parallelism>,
+                                      CLARAKMedoids<value_t, parallelism>>::type>(filepath);
     else
-        distributed(filepath);
+        distributed<std::conditional<strings_equal(kmedoidsMethod, "REG"), DistributedKMedoids<value_t, parallelism>,
+                                     CLARAKMedoids<value_t, parallelism>>::type>(filepath);
 }
\ No newline at end of file
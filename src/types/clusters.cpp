@@ -1,41 +1,110 @@
 #include <hpkmedoids/types/clusters.hpp>
 #include <limits>
+#include <utility>
 
 namespace hpkmedoids
 {
 template <typename T>
 Clusters<T>::Clusters() :
     m_error(std::numeric_limits<T>::max()),
-    p_data(nullptr),
+    m_data(),
     p_distMat(nullptr),
     m_selectedSet(),
     m_assignments(),
-    m_centroids()
+    m_centroids(),
+    m_layout(DataLayout::Auto)
 {
 }
 
 template <typename T>
-Clusters<T>::Clusters(const Matrix<T>* const data, const Matrix<T>* const centroids) :
+Clusters<T>::Clusters(const DataView<T>& data, const Matrix<T>* const centroids) :
     m_error(std::numeric_limits<T>::max()),
-    p_data(data),
+    m_data(data),
     p_distMat(nullptr),
     m_selectedSet(),
-    m_assignments(data->rows()),
-    m_centroids(*centroids)
+    m_assignments(),
+    m_centroids(*centroids),
+    m_layout(DataLayout::Auto)
+{
+}
+
+template <typename T>
+Clusters<T>::Clusters(const DataView<T>& data, Matrix<T>&& centroids, const T error,
+                      std::vector<int32_t>&& assignments) :
+    m_error(error),
+    m_data(data),
+    p_distMat(nullptr),
+    m_selectedSet(),
+    m_assignments(std::move(assignments)),
+    m_centroids(std::move(centroids)),
+    m_layout(DataLayout::Auto)
 {
 }
 
 template <typename T>
-Clusters<T>::Clusters(const Matrix<T>* const data, DistanceMatrix<T>* const distMat) :
+Clusters<T>::Clusters(const DataView<T>& data, DistanceMatrix<T>* const distMat) :
     m_error(std::numeric_limits<T>::max()),
-    p_data(data),
+    m_data(data),
     p_distMat(distMat),
-    m_selectedSet(data->rows(), distMat->numCentroids()),
-    m_assignments(data->rows()),
-    m_centroids(distMat->numCentroids(), data->cols())
+    m_selectedSet(data.rows(), distMat->numCentroids()),
+    m_assignments(data.rows()),
+    m_centroids(distMat->numCentroids(), data.cols()),
+    m_layout(DataLayout::Auto)
 {
 }
 
+template <typename T>
+void Clusters<T>::reset(const DataView<T>& data, DistanceMatrix<T>* const distMat)
+{
+    m_error   = std::numeric_limits<T>::max();
+    m_data    = data;
+    p_distMat = distMat;
+    m_selectedSet.reset(data.rows(), distMat->numCentroids());
+    m_assignments.resize(data.rows());
+    m_centroids.reshape(distMat->numCentroids(), data.cols());
+}
+
+template <typename T>
+void Clusters<T>::clear()
+{
+    m_error   = std::numeric_limits<T>::max();
+    m_data    = DataView<T>();
+    p_distMat = nullptr;
+    m_selectedSet.reset(0, 0);
+    m_assignments.clear();
+    m_centroids.reshape(0, 0);
+}
+
+template <typename T>
+void Clusters<T>::rebind(const DataView<T>& data)
+{
+    m_error   = std::numeric_limits<T>::max();
+    m_data    = data;
+    p_distMat = nullptr;
+    m_selectedSet.reset(0, 0);
+    m_assignments.clear();
+}
+
+template <typename T>
+void Clusters<T>::swap(Clusters& other) noexcept
+{
+    std::swap(m_error, other.m_error);
+    std::swap(m_data, other.m_data);
+    std::swap(p_distMat, other.p_distMat);
+    std::swap(m_selectedSet, other.m_selectedSet);
+    m_assignments.swap(other.m_assignments);
+    std::swap(m_centroids, other.m_centroids);
+}
+
+template <typename T>
+void Clusters<T>::restoreCentroidDistances()
+{
+    for (int32_t centroidIdx = 0; centroidIdx < m_selectedSet.selectedSize(); ++centroidIdx)
+    {
+        p_distMat->updateDistancesToCentroid(m_selectedSet.selected()[centroidIdx], centroidIdx);
+    }
+}
+
 template <typename T>
 bool Clusters<T>::operator<(const Clusters& lhs) const
 {
@@ -51,7 +120,7 @@ bool Clusters<T>::operator>(const Clusters& lhs) const
 template <typename T>
 void Clusters<T>::addCentroid(const int32_t dataIdx)
 {
-    m_centroids.append(p_data->crowBegin(dataIdx), p_data->crowEnd(dataIdx));
+    m_centroids.append(m_data.crowBegin(dataIdx), m_data.crowEnd(dataIdx));
     m_selectedSet.select(dataIdx);
     p_distMat->updateDistancesToCentroid(dataIdx, size() - 1);
 }
@@ -59,7 +128,7 @@ void Clusters<T>::addCentroid(const int32_t dataIdx)
 template <typename T>
 void Clusters<T>::swapCentroid(const int32_t dataIdx, const int32_t centroidIdx)
 {
-    m_centroids.set(centroidIdx, p_data->crowBegin(dataIdx), p_data->crowEnd(dataIdx));
+    m_centroids.set(centroidIdx, m_data.crowBegin(dataIdx), m_data.crowEnd(dataIdx));
     m_selectedSet.replaceSelected(dataIdx, centroidIdx);
     p_distMat->updateDistancesToCentroid(dataIdx, centroidIdx);
 }
@@ -94,12 +163,31 @@ int32_t Clusters<T>::numCandidates() const
     return m_selectedSet.unselectedSize();
 }
 
+template <typename T>
+bool Clusters<T>::isSelected(const int32_t dataIdx) const
+{
+    return m_selectedSet.seleContains(dataIdx);
+}
+
 template <typename T>
 const Matrix<T>* const Clusters<T>::getCentroids() const
 {
     return &m_centroids;
 }
 
+template <typename T>
+std::vector<int32_t> Clusters<T>::getMedoidIndices() const
+{
+    std::vector<int32_t> medoids;
+    medoids.reserve(selected().size());
+    for (const auto& dataIdx : selected())
+    {
+        medoids.push_back(m_data.index(dataIdx));
+    }
+
+    return medoids;
+}
+
 template <typename T>
 const std::vector<int32_t>* const Clusters<T>::getClustering() const
 {
@@ -112,6 +200,12 @@ const T Clusters<T>::getError() const
     return m_error;
 }
 
+template <typename T>
+void Clusters<T>::setLayout(const DataLayout layout)
+{
+    m_layout = layout;
+}
+
 template class Clusters<float>;
 template class Clusters<double>;
 }  // namespace hpkmedoids
\ No newline at end of file
@@ -6,15 +6,9 @@
 namespace hpkmedoids
 {
 template <typename T>
-DistanceMatrix<T>::DistanceMatrix()
-{
-}
-
-template <typename T>
-DistanceMatrix<T>::DistanceMatrix(Matrix<T>&& dataDistMat, const int32_t numClusters) :
-    m_dataDistMat(std::move(dataDistMat)),
-    m_centroidDistMat(m_dataDistMat.rows(), numClusters, true, std::numeric_limits<T>::max())
+DistanceMatrix<T>::DistanceMatrix() : m_features(Matrix<T>::uninitialized(0, 0, true))
 {
+    m_dataDistMat.setAllocationPolicy(Matrix<T>::AllocationPolicy::HugePages);
 }
 
 template <typename T>
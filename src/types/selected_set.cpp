@@ -1,5 +1,6 @@
 #include <hpkmedoids/types/selected_set.hpp>
 #include <numeric>
+#include <string>
 #ifndef __clang__
     #include <algorithm>
     #include <stdexcept>
@@ -7,12 +8,24 @@
 
 namespace hpkmedoids
 {
-SelectedSet::SelectedSet() : m_numClusters(0), m_unselected(), m_selected() {}
+SelectedSet::SelectedSet() : m_numClusters(0), m_unselected(), m_selected(), m_positions(), m_isSelected() {}
 
 SelectedSet::SelectedSet(const int32_t numData, const int32_t numClusters) :
-    m_numClusters(numClusters), m_unselected(numData), m_selected(0)
+    m_numClusters(numClusters), m_unselected(numData), m_selected(0), m_positions(numData), m_isSelected(numData)
 {
     std::iota(unseleBegin(), unseleEnd(), 0);
+    std::iota(m_positions.begin(), m_positions.end(), 0);
+}
+
+void SelectedSet::reset(const int32_t numData, const int32_t numClusters)
+{
+    m_numClusters = numClusters;
+    m_selected.clear();
+    m_unselected.resize(numData);
+    m_positions.resize(numData);
+    m_isSelected.assign(numData, false);
+    std::iota(unseleBegin(), unseleEnd(), 0);
+    std::iota(m_positions.begin(), m_positions.end(), 0);
 }
 
 void SelectedSet::select(const int32_t idx)
@@ -20,26 +33,24 @@ void SelectedSet::select(const int32_t idx)
     if (static_cast<int32_t>(m_selected.size()) >= m_numClusters)
         throw std::length_error("The maximum number of centroids has already been selected!");
 
-    m_unselected.erase(std::find(cunseleBegin(), cunseleEnd(), idx));
+    removeUnselected(idx);
+    m_positions[idx]  = selectedSize();
+    m_isSelected[idx] = true;
     m_selected.push_back(idx);
 }
 
 void SelectedSet::replaceSelected(const int32_t dataIdx, const int32_t centroidIdx)
 {
-    m_unselected.push_back(m_selected[centroidIdx]);
-    m_unselected.erase(std::find(cunseleBegin(), cunseleEnd(), dataIdx));
+    removeUnselected(dataIdx);
+    appendUnselected(m_selected[centroidIdx]);
+    m_positions[dataIdx]    = centroidIdx;
+    m_isSelected[dataIdx]   = true;
     m_selected[centroidIdx] = dataIdx;
 }
 
-bool SelectedSet::seleContains(const int32_t idx)
-{
-    return std::find(m_selected.cbegin(), m_selected.cend(), idx) != m_selected.cend();
-}
+bool SelectedSet::seleContains(const int32_t idx) const { return inRange(idx) && m_isSelected[idx]; }
 
-bool SelectedSet::unseleContains(const int32_t idx)
-{
-    return std::find(m_unselected.cbegin(), m_unselected.cend(), idx) != m_unselected.cend();
-}
+bool SelectedSet::unseleContains(const int32_t idx) const { return inRange(idx) && !m_isSelected[idx]; }
 
 typename SelectedSet::iterator SelectedSet::seleBegin() { return m_selected.begin(); }
 
@@ -68,4 +79,27 @@ int32_t SelectedSet::selectedSize() const { return static_cast<int32_t>(m_select
 int32_t SelectedSet::unselectedSize() const { return static_cast<int32_t>(m_unselected.size()); }
 
 int32_t SelectedSet::maxSelectedSize() const { return m_numClusters; }
+
+void SelectedSet::removeUnselected(const int32_t idx)
+{
+    if (!unseleContains(idx))
+        throw std::out_of_range("Index " + std::to_string(idx) + " is not an unselected point!");
+
+    auto last                      = m_unselected.back();
+    m_unselected[m_positions[idx]] = last;
+    m_positions[last]              = m_positions[idx];
+    m_unselected.pop_back();
+}
+
+void SelectedSet::appendUnselected(const int32_t idx)
+{
+    m_positions[idx]  = unselectedSize();
+    m_isSelected[idx] = false;
+    m_unselected.push_back(idx);
+}
+
+bool SelectedSet::inRange(const int32_t idx) const
+{
+    return idx >= 0 && idx < static_cast<int32_t>(m_positions.size());
+}
 }  // namespace hpkmedoids
\ No newline at end of file
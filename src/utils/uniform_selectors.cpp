@@ -1,36 +1,91 @@
-#include <boost/generator_iterator.hpp>
-#include <boost/random.hpp>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <hpkmedoids/utils/counter_rng.hpp>
 #include <hpkmedoids/utils/uniform_selectors.hpp>
 
 namespace hpkmedoids
 {
-typedef boost::random::mt19937 RNGType;
-
 AbstractUniformSelector::AbstractUniformSelector(const int64_t* seed, const int min) : m_seed(0), m_min(min)
 {
+    // selectors created within the same clock tick must still get distinct seeds
+    static std::atomic<int64_t> numSelectors(0);
+
     if (seed == nullptr)
         m_seed =
           std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
-            .count();
+            .count() +
+          numSelectors++;
     else
         m_seed = *seed;
 }
 
-UniformSelector::UniformSelector(const int64_t* seed, const int min) : AbstractUniformSelector(seed, min) {}
+int64_t AbstractUniformSelector::getSeed() const { return m_seed; }
+
+void AbstractUniformSelector::setSeed(const int64_t seed) { m_seed = seed; }
+
+UniformSelector::UniformSelector(const int64_t* seed, const int min) :
+    AbstractUniformSelector(seed, min), m_nextStream(IMPLICIT_STREAMS_BEGIN)
+{
+}
+
+std::vector<int32_t> UniformSelector::select(const int sampleSize, const int32_t containerSize) const
+{
+    return select(sampleSize, containerSize, m_nextStream++);
+}
+
+std::vector<int32_t> UniformSelector::select(const int sampleSize, const int32_t containerSize,
+                                             const uint64_t stream) const
+{
+    std::vector<int32_t> selections;
+    select(sampleSize, containerSize, stream, selections);
+    return selections;
+}
+
+void UniformSelector::select(const int sampleSize, const int32_t containerSize, std::vector<int32_t>& selections) const
+{
+    select(sampleSize, containerSize, m_nextStream++, selections);
+}
 
-std::set<int32_t> UniformSelector::select(const int sampleSize, const int32_t containerSize) const
+void UniformSelector::select(const int sampleSize, const int32_t containerSize, const uint64_t stream,
+                             std::vector<int32_t>& selections) const
 {
-    static RNGType rng(m_seed);
-    static boost::random::uniform_int_distribution<> dist(m_min, containerSize - 1);
-    static boost::variate_generator<RNGType, boost::random::uniform_int_distribution<>> gen(rng, dist);
+    CounterRNG rng(m_seed, stream);
+    auto range = std::max(containerSize - m_min, 0);
+    auto count = std::clamp(sampleSize, 0, range);
+    selections.clear();
+    selections.reserve(count);
 
-    std::set<int32_t> selections;
-    while (static_cast<int>(selections.size()) < sampleSize)
+    if (count <= SORTED_INSERT_LIMIT)
     {
-        selections.insert(gen());
+        // j is larger than every index selected so far, so it is always appended
+        for (int32_t j = range - count; j < range; ++j)
+        {
+            auto candidate = m_min + static_cast<int32_t>(rng.uniform(j + 1));
+            auto pos       = std::lower_bound(selections.begin(), selections.end(), candidate);
+            if (pos != selections.end() && *pos == candidate)
+                selections.push_back(m_min + j);
+            else
+                selections.insert(pos, candidate);
+        }
     }
+    else
+    {
+        std::vector<uint64_t> selected((range + 63) / 64, 0);
+        for (int32_t j = range - count; j < range; ++j)
+        {
+            auto candidate = static_cast<int32_t>(rng.uniform(j + 1));
+            auto idx       = (selected[candidate / 64] >> (candidate % 64)) & 1 ? j : candidate;
+            selected[idx / 64] |= uint64_t(1) << (idx % 64);
+        }
 
-    return selections;
+        for (int32_t word = 0; word < static_cast<int32_t>(selected.size()); ++word)
+        {
+            for (auto bits = selected[word]; bits != 0; bits &= bits - 1)
+            {
+                selections.push_back(m_min + word * 64 + __builtin_ctzll(bits));
+            }
+        }
+    }
 }
-}  // namespace hpkmedoids
\ No newline at end of file
+}  // namespace hpkmedoids
@@ -0,0 +1,128 @@
+#include <hpkmedoids/filesystem/dataset.hpp>
+#define BOOST_TEST_MODULE test_dataset
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <numeric>
+
+using namespace hpkmedoids;
+
+struct DatasetFixture
+{
+    DatasetFixture() : data(7, 3, true), filepath("test_dataset.bin")
+    {
+        std::iota(data.begin(), data.end(), 0.5);
+    }
+
+    ~DatasetFixture() { std::remove(filepath.c_str()); }
+
+    Matrix<double> data;
+    std::string filepath;
+};
+
+BOOST_FIXTURE_TEST_CASE(test_round_trip, DatasetFixture)
+{
+    DatasetWriter<double>().write(data, filepath);
+
+    DatasetHeader header;
+    BOOST_TEST(readDatasetHeader(filepath, &header));
+    BOOST_TEST(header.rows == 7);
+    BOOST_TEST(header.cols == 3);
+    BOOST_TEST(header.stride == 3);
+    BOOST_TEST(header.hasChecksum());
+    BOOST_TEST(header.payloadOffset() % DatasetHeader::DEFAULT_ALIGNMENT == 0);
+
+    auto result = DatasetReader<double>().read(filepath);
+    BOOST_TEST((result == data));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_padded_rows, DatasetFixture)
+{
+    DatasetWriter<double>(true).write(data, filepath);
+
+    DatasetHeader header;
+    readDatasetHeader(filepath, &header);
+    BOOST_TEST(header.stride == Matrix<double>::paddedCols(3));
+
+    auto result = DatasetReader<double>().read(filepath);
+    BOOST_TEST((result == data));
+
+    auto padded = DatasetReader<double>(true).read(filepath);
+    BOOST_TEST(padded.ld() == header.stride);
+    for (int64_t i = 0; i < data.rows(); ++i)
+    {
+        BOOST_TEST(std::equal(data.crowBegin(i), data.crowEnd(i), padded.crowBegin(i)));
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_conversion, DatasetFixture)
+{
+    Matrix<float> floats(data.rows(), data.cols(), true);
+    std::iota(floats.begin(), floats.end(), 0.5f);
+    DatasetWriter<float>().write(floats, filepath);
+
+    auto result = DatasetReader<double>().read(filepath);
+    BOOST_TEST((result == data));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_raw_file, DatasetFixture)
+{
+    std::ofstream file(filepath, std::ios::out | std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), data.bytes());
+    file.close();
+
+    DatasetHeader header;
+    BOOST_TEST(!readDatasetHeader(filepath, &header));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_append_blocks, DatasetFixture)
+{
+    DatasetWriter<double> writer(true);
+    writer.open(filepath, data.cols());
+    writer.append(MatrixView<double>(data).rowRange(0, 4));
+    writer.append(MatrixView<double>(data).rowRange(4, 3));
+    writer.finish();
+
+    auto result = DatasetReader<double>().read(filepath);
+    BOOST_TEST((result == data));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_convert_raw, DatasetFixture)
+{
+    std::string rawPath = "test_dataset.raw";
+    std::ofstream file(rawPath, std::ios::out | std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), data.bytes());
+    file.close();
+
+    convertRawDataset<double>(rawPath, filepath, data.rows(), data.cols());
+    std::remove(rawPath.c_str());
+
+    auto result = DatasetReader<double>().read(filepath);
+    BOOST_TEST((result == data));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_header_status, DatasetFixture)
+{
+    DatasetHeader header;
+    BOOST_TEST((checkDatasetHeader("missing_dataset.bin", &header) == HeaderStatus::Invalid));
+
+    DatasetWriter<double>().write(data, filepath);
+    BOOST_TEST((checkDatasetHeader(filepath, &header) == HeaderStatus::Dataset));
+
+    std::ifstream file(filepath, std::ios::in | std::ios::binary);
+    std::vector<char> bytes(header.payloadOffset() + header.payloadBytes() - 1);
+    file.read(bytes.data(), bytes.size());
+    file.close();
+
+    std::ofstream truncated(filepath, std::ios::out | std::ios::binary);
+    truncated.write(bytes.data(), bytes.size());
+    truncated.close();
+    BOOST_TEST((checkDatasetHeader(filepath, &header) == HeaderStatus::Invalid));
+}
+
+BOOST_AUTO_TEST_CASE(test_checksum)
+{
+    const char bytes[] = "abcdef";
+    auto whole         = datasetChecksum(bytes, 6);
+    BOOST_TEST(datasetChecksum(bytes + 2, 4, datasetChecksum(bytes, 2)) == whole);
+    BOOST_TEST(datasetChecksum(bytes, 5) != whole);
+}
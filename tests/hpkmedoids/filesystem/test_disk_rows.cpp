@@ -0,0 +1,115 @@
+#include <hpkmedoids/filesystem/disk_rows.hpp>
+#define BOOST_TEST_MODULE test_disk_rows
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <numeric>
+
+using namespace hpkmedoids;
+
+struct DiskRowsFixture
+{
+    DiskRowsFixture() : data(100, 3, true), rawPath("test_disk_rows.raw"), datasetPath("test_disk_rows.bin")
+    {
+        std::iota(data.begin(), data.end(), 0.0);
+
+        std::ofstream file(rawPath, std::ios::out | std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()), data.bytes());
+        file.close();
+
+        DatasetWriter<double>(true).write(data, datasetPath);
+    }
+
+    ~DiskRowsFixture()
+    {
+        std::remove(rawPath.c_str());
+        std::remove(datasetPath.c_str());
+    }
+
+    Matrix<double> data;
+    std::string rawPath;
+    std::string datasetPath;
+};
+
+BOOST_AUTO_TEST_CASE(test_coalesce_rows)
+{
+    std::vector<std::pair<int32_t, int32_t>> sortedRows = { { 1, 0 }, { 2, 3 }, { 2, 4 }, { 5, 1 }, { 40, 2 } };
+    auto ranges = coalesceRows(sortedRows, 8, 16, 64);
+
+    BOOST_TEST(ranges.size() == 2);
+    BOOST_TEST(ranges[0].firstRow == 1);
+    BOOST_TEST(ranges[0].numRows == 5);
+    BOOST_TEST(ranges[0].begin == 0);
+    BOOST_TEST(ranges[0].end == 4);
+    BOOST_TEST(ranges[1].firstRow == 40);
+    BOOST_TEST(ranges[1].numRows == 1);
+
+    auto bounded = coalesceRows(sortedRows, 8, 16, 16);
+    BOOST_TEST(bounded.size() == 3);
+    BOOST_TEST(bounded[0].numRows == 2);
+    BOOST_TEST(bounded[1].firstRow == 5);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_gather, DiskRowsFixture)
+{
+    std::vector<int32_t> selections = { 97, 3, 4, 50, 0, 51 };
+    for (const auto& path : { rawPath, datasetPath })
+    {
+        auto rows = path == rawPath ? std::make_unique<DiskRows<double>>(path, 100, 3)
+                                    : std::make_unique<DiskRows<double>>(path);
+        BOOST_TEST(rows->rows() == 100);
+        BOOST_TEST(rows->cols() == 3);
+
+        Matrix<double> serial(selections.size(), 3, true);
+        Matrix<double> parallel(selections.size(), 3, true);
+        rows->gather<Parallelism::Serial>(selections, &serial);
+        rows->gather<Parallelism::OMP>(selections, &parallel);
+        for (int32_t i = 0; i < static_cast<int32_t>(selections.size()); ++i)
+        {
+            BOOST_TEST(std::equal(serial.crowBegin(i), serial.crowEnd(i), data.crowBegin(selections[i])));
+            BOOST_TEST(std::equal(parallel.crowBegin(i), parallel.crowEnd(i), data.crowBegin(selections[i])));
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_conversion, DiskRowsFixture)
+{
+    Matrix<float> floats(data.rows(), data.cols(), true);
+    std::iota(floats.begin(), floats.end(), 0.0f);
+    DatasetWriter<float>(true).write(floats, datasetPath);
+
+    DiskRows<double> rows(datasetPath);
+    std::vector<int32_t> selections = { 97, 3, 4, 50, 0, 51 };
+    Matrix<double> sample(selections.size(), 3, true);
+    rows.gather<Parallelism::Serial>(selections, &sample);
+    for (int32_t i = 0; i < static_cast<int32_t>(selections.size()); ++i)
+    {
+        BOOST_TEST(std::equal(sample.crowBegin(i), sample.crowEnd(i), data.crowBegin(selections[i])));
+    }
+
+    Matrix<double> all(data.rows(), data.cols(), true);
+    rows.read(0, data.rows(), &all);
+    BOOST_TEST((all == data));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_stream, DiskRowsFixture)
+{
+    for (const auto& path : { rawPath, datasetPath })
+    {
+        auto rows = path == rawPath ? std::make_unique<DiskRows<double>>(path, 100, 3)
+                                    : std::make_unique<DiskRows<double>>(path);
+
+        int64_t streamed = 0;
+        rows->stream(
+          [&](const int64_t firstRow, const MatrixView<double>& block) {
+              BOOST_TEST(firstRow == streamed);
+              BOOST_TEST(block.rows() <= 16);
+              for (int64_t i = 0; i < block.rows(); ++i)
+              {
+                  BOOST_TEST(std::equal(block.crowBegin(i), block.crowEnd(i), data.crowBegin(firstRow + i)));
+              }
+              streamed += block.rows();
+          },
+          16);
+        BOOST_TEST(streamed == 100);
+    }
+}
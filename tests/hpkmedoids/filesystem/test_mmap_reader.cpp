@@ -0,0 +1,110 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <hpkmedoids/filesystem/mmap_reader.hpp>
+#define BOOST_TEST_MODULE test_mmap_reader
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <numeric>
+
+using namespace hpkmedoids;
+
+struct MmapReaderFixture
+{
+    MmapReaderFixture() : data(100, 3, true), rawPath("test_mmap_reader.raw"), datasetPath("test_mmap_reader.bin")
+    {
+        std::iota(data.begin(), data.end(), 0.5);
+
+        std::ofstream file(rawPath, std::ios::out | std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()), data.bytes());
+        file.close();
+    }
+
+    ~MmapReaderFixture()
+    {
+        std::remove(rawPath.c_str());
+        std::remove(datasetPath.c_str());
+    }
+
+    void checkView(const MatrixView<double>& view)
+    {
+        BOOST_TEST(view.rows() == data.rows());
+        BOOST_TEST(view.cols() == data.cols());
+        for (int64_t i = 0; i < data.rows(); ++i)
+        {
+            BOOST_CHECK_EQUAL_COLLECTIONS(view.crowBegin(i), view.crowEnd(i), data.crowBegin(i), data.crowEnd(i));
+        }
+    }
+
+    Matrix<double> data;
+    std::string rawPath;
+    std::string datasetPath;
+};
+
+// Runs read in a child process, since the reader exits on errors, and returns its exit status.
+template <class Read>
+int exitStatus(Read read)
+{
+    auto pid = fork();
+    if (pid == 0)
+    {
+        read();
+        _exit(0);
+    }
+
+    int status;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+BOOST_FIXTURE_TEST_CASE(test_raw_round_trip, MmapReaderFixture)
+{
+    MmapMatrixReader<double> reader;
+    checkView(reader.read(rawPath, data.rows(), data.cols()));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_dataset, MmapReaderFixture)
+{
+    DatasetWriter<double>(true).write(data, datasetPath);
+
+    MmapMatrixReader<double> reader(AccessPattern::Random);
+    auto view = reader.readDataset(datasetPath);
+    BOOST_TEST(view.ld() == Matrix<double>::paddedCols(data.cols()));
+    checkView(view);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_conversion, MmapReaderFixture)
+{
+    Matrix<float> floats(data.rows(), data.cols(), true);
+    std::iota(floats.begin(), floats.end(), 0.5f);
+    DatasetWriter<float>().write(floats, datasetPath);
+
+    MmapMatrixReader<double> reader;
+    auto view = reader.readDataset(datasetPath);
+
+    // Converted matrices stay put while the reader keeps more of them.
+    for (int i = 0; i < 4; ++i)
+    {
+        reader.readDataset(datasetPath);
+    }
+    checkView(view);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_empty, MmapReaderFixture)
+{
+    std::ofstream file(datasetPath, std::ios::out | std::ios::binary);
+    file.close();
+
+    MmapMatrixReader<double> reader;
+    auto view = reader.read(datasetPath, 0, data.cols());
+    BOOST_TEST(view.rows() == 0);
+    BOOST_TEST(view.cols() == data.cols());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_too_small, MmapReaderFixture)
+{
+    MmapMatrixReader<double> reader;
+    BOOST_TEST(exitStatus([&]() { reader.read(rawPath, data.rows() + 1, data.cols()); }) == 1);
+    BOOST_TEST(exitStatus([&]() { reader.read("missing_mmap_reader.raw", 1, 1); }) == 1);
+    BOOST_TEST(exitStatus([&]() { reader.readDataset(rawPath); }) == 1);
+}
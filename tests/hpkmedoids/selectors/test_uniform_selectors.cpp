@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <hpkmedoids/utils/uniform_selectors.hpp>
 #define BOOST_TEST_MODULE test_parallelism
 #include <boost/test/data/test_case.hpp>
@@ -28,3 +29,56 @@ BOOST_FIXTURE_TEST_CASE(test_serial_uniform_selector, UniformSelectorFixture)
                            [&CONTAINER_SIZE](const int32_t val) { return val <= CONTAINER_SIZE - 1 && val >= 0; }));
     BOOST_TEST(static_cast<int>(selections.size()) == SELECTION_SIZE);
 }
+
+BOOST_FIXTURE_TEST_CASE(test_selections_sorted_and_unique, UniformSelectorFixture)
+{
+    for (auto sampleSize : { 1, 40, UniformSelector::SORTED_INSERT_LIMIT + 1, 10000 })
+    {
+        auto selections = selector.select(sampleSize, 10000);
+
+        BOOST_TEST(static_cast<int>(selections.size()) == sampleSize);
+        BOOST_TEST(std::is_sorted(selections.begin(), selections.end()));
+        BOOST_TEST((std::adjacent_find(selections.begin(), selections.end()) == selections.end()));
+        BOOST_TEST(selections.front() >= 0);
+        BOOST_TEST(selections.back() <= 9999);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_stream_selections_reproducible, UniformSelectorFixture)
+{
+    UniformSelector other(&seed, 0);
+    std::vector<int32_t> reused;
+    other.select(60, 10000, 3, reused);
+
+    BOOST_TEST(selector.select(60, 10000, 3) == other.select(60, 10000, 3));
+    BOOST_TEST(selector.select(60, 10000, 3) == reused);
+    BOOST_TEST(selector.select(60, 10000, 3) != selector.select(60, 10000, 4));
+}
+
+BOOST_AUTO_TEST_CASE(test_selections_respect_min)
+{
+    UniformSelector offsetSelector(&seed, 5);
+    auto selections = offsetSelector.select(10, 15, 0);
+
+    BOOST_TEST(selections.size() == 10);
+    BOOST_TEST(std::all_of(selections.begin(), selections.end(),
+                           [](const int32_t val) { return val >= 5 && val <= 14; }));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_oversized_sample_selects_whole_range, UniformSelectorFixture)
+{
+    for (auto sampleSize : { 41, 60, UniformSelector::SORTED_INSERT_LIMIT + 1 })
+    {
+        auto selections = selector.select(sampleSize, 40);
+
+        BOOST_TEST(selections.size() == 40);
+        for (int32_t i = 0; i < 40; ++i)
+        {
+            BOOST_TEST(selections[i] == i);
+        }
+    }
+
+    UniformSelector offsetSelector(&seed, 5);
+    BOOST_TEST(offsetSelector.select(20, 15, 0).size() == 10);
+    BOOST_TEST(offsetSelector.select(20, 3, 0).empty());
+}
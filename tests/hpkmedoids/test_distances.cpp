@@ -1,4 +1,5 @@
 #include <hpkmedoids/distances.hpp>
+#include <hpkmedoids/utils/feature_major.hpp>
 #include <vector>
 #define BOOST_TEST_MODULE test_distances
 #include <boost/test/unit_test.hpp>
@@ -20,3 +21,37 @@ BOOST_AUTO_TEST_CASE(test_l1norm)
     std::vector<double> vec2 = { 46.0, -2.0, 1.0, 47.0 };
     BOOST_TEST(distanceFunc(vec1.begin(), vec1.end(), vec2.begin(), vec2.end()) == 96.0, tt::tolerance(0.01));
 }
+
+template <class DistanceFunc>
+void checkBatchKernel()
+{
+    const int64_t numPoints = DISTANCE_BATCH_SIZE + 37;
+    Matrix<double> points(numPoints, 3, true);
+    for (int64_t i = 0; i < points.size(); ++i)
+    {
+        points.data()[i] = (i * 7919 % 101) - 50.0;
+    }
+
+    Matrix<double> features = Matrix<double>::uninitialized(0, 0, true);
+    hpkmedoids::transposeRows(&points, 0, numPoints, &features);
+    BOOST_TEST(features.ld() > numPoints);
+
+    DistanceFunc distanceFunc;
+    std::vector<double> query = { 3.0, -2.5, 11.0 };
+    std::vector<double> distances(numPoints);
+    distanceFunc.batch(query.cbegin(), query.cend(), features.data(), features.ld(), numPoints, distances.data());
+    for (int64_t j = 0; j < numPoints; ++j)
+    {
+        BOOST_TEST(distances[j] == distanceFunc(query.cbegin(), query.cend(), points.crowBegin(j), points.crowEnd(j)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_l2norm_batch)
+{
+    checkBatchKernel<L2Norm<double>>();
+}
+
+BOOST_AUTO_TEST_CASE(test_l1norm_batch)
+{
+    checkBatchKernel<L1Norm<double>>();
+}
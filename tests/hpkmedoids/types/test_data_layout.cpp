@@ -0,0 +1,112 @@
+#include <hpkmedoids/distances.hpp>
+#include <hpkmedoids/types/clusters.hpp>
+#include <hpkmedoids/utils/distance_calculator.hpp>
+#include <hpkmedoids/utils/feature_major.hpp>
+#define BOOST_TEST_MODULE test_data_layout
+#include <boost/test/unit_test.hpp>
+
+using namespace hpkmedoids;
+namespace tt = boost::test_tools;
+
+// L1Norm without a batch kernel, so feature-major layouts fall back to the row kernel.
+struct RowOnlyL1Norm
+{
+    template <typename Iter1, typename Iter2>
+    double operator()(Iter1 begin1, Iter1 end1, Iter2 begin2, Iter2 end2) const
+    {
+        return L1Norm<double>()(begin1, end1, begin2, end2);
+    }
+};
+
+static_assert(HasBatchKernel<double, L2Norm<double>>::value);
+static_assert(!HasBatchKernel<double, RowOnlyL1Norm>::value);
+
+struct DataLayoutFixture
+{
+    DataLayoutFixture() : data(3 * DISTANCE_BATCH_SIZE + 41, 3, true), centroids(5, 3, true)
+    {
+        for (int64_t i = 0; i < data.size(); ++i)
+        {
+            data.data()[i] = (i * 7919 % 101) - 50.0;
+        }
+
+        for (int32_t c = 0; c < centroids.rows(); ++c)
+        {
+            centroids.set(c, data.crowBegin(c * 97), data.crowEnd(c * 97));
+        }
+    }
+
+    Matrix<double> data;
+    Matrix<double> centroids;
+};
+
+template <Parallelism Level, class DistanceFunc, class ReferenceFunc = DistanceFunc>
+void checkDistanceCalculator(const Matrix<double>* const data)
+{
+    Matrix<double> rowMajor;
+    DistanceCalculator<double, Level, ReferenceFunc>(DataLayout::RowMajor)
+      .calculateDistanceMatrix(data, data, &rowMajor);
+
+    Matrix<double> featureMajor;
+    DistanceCalculator<double, Level, DistanceFunc>(DataLayout::FeatureMajor)
+      .calculateDistanceMatrix(data, data, &featureMajor);
+
+    BOOST_TEST(featureMajor.rows() == rowMajor.rows());
+    BOOST_TEST(featureMajor.cols() == rowMajor.cols());
+    for (int32_t i = 0; i < rowMajor.rows(); ++i)
+    {
+        BOOST_CHECK_EQUAL_COLLECTIONS(featureMajor.crowBegin(i), featureMajor.crowEnd(i), rowMajor.crowBegin(i),
+                                      rowMajor.crowEnd(i));
+    }
+}
+
+template <Parallelism Level, class DistanceFunc, class ReferenceFunc = DistanceFunc>
+void checkClusters(const Matrix<double>* const data, const Matrix<double>* const centroids)
+{
+    ReferenceFunc referenceFunc;
+    Clusters<double> rowMajor(DataView<double>(data), centroids);
+    rowMajor.setLayout(DataLayout::RowMajor);
+    rowMajor.calculateAssignmentsFromCentroids<Level>(referenceFunc);
+
+    DistanceFunc distanceFunc;
+    Clusters<double> featureMajor(DataView<double>(data), centroids);
+    featureMajor.setLayout(DataLayout::FeatureMajor);
+    featureMajor.calculateAssignmentsFromCentroids<Level>(distanceFunc);
+
+    BOOST_TEST(featureMajor.getError() == rowMajor.getError());
+    BOOST_TEST(*featureMajor.getClustering() == *rowMajor.getClustering(), tt::per_element());
+
+    // The scratch space of the first search is reused by the second one.
+    BOOST_TEST(featureMajor.calculateErrorFromCentroids<Level>(distanceFunc, std::numeric_limits<double>::max()));
+    BOOST_TEST(featureMajor.getError() == rowMajor.getError());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_distance_calculator_serial, DataLayoutFixture)
+{
+    checkDistanceCalculator<Parallelism::Serial, L2Norm<double>>(&data);
+    checkDistanceCalculator<Parallelism::Serial, L1Norm<double>>(&data);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_distance_calculator_omp, DataLayoutFixture)
+{
+    checkDistanceCalculator<Parallelism::OMP, L2Norm<double>>(&data);
+    checkDistanceCalculator<Parallelism::OMP, L1Norm<double>>(&data);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_clusters_serial, DataLayoutFixture)
+{
+    checkClusters<Parallelism::Serial, L2Norm<double>>(&data, &centroids);
+    checkClusters<Parallelism::Serial, L1Norm<double>>(&data, &centroids);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_clusters_omp, DataLayoutFixture)
+{
+    checkClusters<Parallelism::OMP, L2Norm<double>>(&data, &centroids);
+    checkClusters<Parallelism::OMP, L1Norm<double>>(&data, &centroids);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_row_kernel_fallback, DataLayoutFixture)
+{
+    checkDistanceCalculator<Parallelism::Serial, RowOnlyL1Norm, L1Norm<double>>(&data);
+    checkClusters<Parallelism::OMP, RowOnlyL1Norm, L1Norm<double>>(&data, &centroids);
+}
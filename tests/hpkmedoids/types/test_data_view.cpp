@@ -0,0 +1,60 @@
+#include <hpkmedoids/types/data_view.hpp>
+#define BOOST_TEST_MODULE test_data_view
+#include <boost/test/unit_test.hpp>
+#include <numeric>
+
+using namespace hpkmedoids;
+
+struct DataViewFixture
+{
+    DataViewFixture() : data(10, 3, true), indices({ 1, 4, 8 })
+    {
+        std::iota(data.begin(), data.end(), 0.0);
+    }
+
+    ~DataViewFixture() {}
+
+    Matrix<double> data;
+    std::vector<int32_t> indices;
+};
+
+BOOST_FIXTURE_TEST_CASE(test_full_view, DataViewFixture)
+{
+    DataView<double> view(&data);
+
+    BOOST_TEST(view.rows() == data.rows());
+    BOOST_TEST(view.numRows() == data.numRows());
+    BOOST_TEST(view.cols() == data.cols());
+    BOOST_TEST(view.index(7) == 7);
+    BOOST_CHECK_EQUAL_COLLECTIONS(view.crowBegin(7), view.crowEnd(7), data.crowBegin(7), data.crowEnd(7));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_indexed_view, DataViewFixture)
+{
+    DataView<double> view(&data, &indices);
+
+    BOOST_TEST(view.rows() == 3);
+    BOOST_TEST(view.numRows() == 3);
+    BOOST_TEST(view.cols() == data.cols());
+    BOOST_TEST(view.base().data() == data.data());
+    for (int32_t i = 0; i < view.rows(); ++i)
+    {
+        BOOST_TEST(view.index(i) == indices[i]);
+        BOOST_CHECK_EQUAL_COLLECTIONS(view.crowBegin(i), view.crowEnd(i), data.crowBegin(indices[i]),
+                                      data.crowEnd(indices[i]));
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_submatrix_view, DataViewFixture)
+{
+    auto base = MatrixView<double>(data).colRange(1, 2);
+    DataView<double> view(base, &indices);
+
+    BOOST_TEST(view.rows() == 3);
+    BOOST_TEST(view.cols() == 2);
+    for (int32_t i = 0; i < view.rows(); ++i)
+    {
+        BOOST_CHECK_EQUAL_COLLECTIONS(view.crowBegin(i), view.crowEnd(i), data.crowBegin(indices[i]) + 1,
+                                      data.crowEnd(indices[i]));
+    }
+}
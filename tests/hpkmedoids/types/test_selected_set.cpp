@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <array>
 #include <hpkmedoids/types/selected_set.hpp>
 #define BOOST_TEST_MODULE test_selected_set
 #include <boost/test/unit_test.hpp>
+#include <vector>
 
 using namespace hpkmedoids;
 
@@ -63,4 +65,59 @@ BOOST_FIXTURE_TEST_CASE(test_selected_set_replaceSelected, SelectedSetFixture)
     BOOST_TEST(std::distance(selectedSet.seleBegin(),
                              std::find(selectedSet.seleBegin(), selectedSet.seleEnd(), dataIdx)) == centroidIdx);
     BOOST_TEST(selectedSet.unseleContains(prevSelection));
-}
\ No newline at end of file
+}
+
+BOOST_FIXTURE_TEST_CASE(test_selected_set_reset, SelectedSetFixture)
+{
+    selectIndices(selectedSet);
+    selectedSet.reset(numData / 2, numClusters - 1);
+
+    BOOST_TEST(selectedSet.selectedSize() == 0);
+    BOOST_TEST(selectedSet.unselectedSize() == numData / 2);
+    BOOST_TEST(selectedSet.maxSelectedSize() == numClusters - 1);
+    for (int32_t i = 0; i < numData / 2; ++i)
+    {
+        BOOST_TEST(selectedSet.cunseleBegin()[i] == i);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_selected_set_membership, SelectedSetFixture)
+{
+    auto indices = selectIndices(selectedSet);
+    selectedSet.replaceSelected(67, 3);
+
+    for (int32_t i = 0; i < numData; ++i)
+    {
+        auto isSelected = i == 67 || (std::find(indices.begin(), indices.end(), i) != indices.end() && i != indices[3]);
+        BOOST_TEST(selectedSet.seleContains(i) == isSelected);
+        BOOST_TEST(selectedSet.unseleContains(i) == !isSelected);
+    }
+
+    BOOST_TEST(!selectedSet.seleContains(-1));
+    BOOST_TEST(!selectedSet.unseleContains(numData));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_selected_set_unselected_is_dense, SelectedSetFixture)
+{
+    selectIndices(selectedSet);
+    selectedSet.replaceSelected(67, 3);
+    selectedSet.replaceSelected(0, 0);
+
+    std::vector<int32_t> all(selectedSet.cunseleBegin(), selectedSet.cunseleEnd());
+    all.insert(all.end(), selectedSet.cseleBegin(), selectedSet.cseleEnd());
+    std::sort(all.begin(), all.end());
+
+    BOOST_TEST(selectedSet.unselectedSize() == numData - numClusters);
+    BOOST_TEST(static_cast<int32_t>(all.size()) == numData);
+    for (int32_t i = 0; i < numData; ++i)
+    {
+        BOOST_TEST(all[i] == i);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_selected_set_select_selected_fail, SelectedSetFixture)
+{
+    selectedSet.select(5);
+    BOOST_CHECK_THROW(selectedSet.select(5), std::out_of_range);
+    BOOST_CHECK_THROW(selectedSet.replaceSelected(5, 0), std::out_of_range);
+}
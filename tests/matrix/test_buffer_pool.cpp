@@ -0,0 +1,88 @@
+#include <matrix/buffer_pool.hpp>
+#include <matrix/matrix.hpp>
+#define BOOST_TEST_MODULE test_buffer_pool
+#include <boost/mpl/list.hpp>
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+
+typedef boost::mpl::list<float, double> test_types;
+
+BOOST_AUTO_TEST_SUITE(buffer_pool)
+
+BOOST_AUTO_TEST_CASE(test_reuses_size_class)
+{
+    BufferPool pool;
+    auto first = pool.allocate(100, 8);
+    pool.deallocate(first, 100, 8);
+
+    auto second = pool.allocate(128, 8);
+    BOOST_TEST(second == first);
+    BOOST_TEST(pool.reserved() == 128);
+
+    auto third = pool.allocate(129, 8);
+    BOOST_TEST(third != first);
+    BOOST_TEST(pool.reserved() == 128 + 256);
+}
+
+BOOST_AUTO_TEST_CASE(test_block_alignment)
+{
+    BufferPool pool;
+    for (size_t bytes = 1; bytes < 4096; bytes *= 3)
+    {
+        auto ptr = pool.allocate(bytes, 16);
+        BOOST_TEST(reinterpret_cast<uintptr_t>(ptr) % BufferPool::BLOCK_ALIGNMENT == 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_over_aligned)
+{
+    BufferPool pool;
+    auto ptr = pool.allocate(100, 4096);
+    BOOST_TEST(reinterpret_cast<uintptr_t>(ptr) % 4096 == 0);
+    BOOST_TEST(pool.reserved() == 100);
+
+    pool.deallocate(ptr, 100, 4096);
+    BOOST_TEST(pool.reserved() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_release)
+{
+    BufferPool pool;
+    auto large = pool.allocate(1000, 8);
+    auto small = pool.allocate(10, 8);
+    BOOST_TEST(large != nullptr);
+    BOOST_TEST(small != nullptr);
+    BOOST_TEST(pool.reserved() > 0);
+
+    pool.release();
+    BOOST_TEST(pool.reserved() == 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_matrix_storage, T, test_types)
+{
+    BufferPool pool;
+    T* data;
+    {
+        Matrix<T> matrix(&pool);
+        matrix.reshape(10, 50, true, 3.0);
+        BOOST_TEST(matrix.memoryResource() == &pool);
+        BOOST_TEST(matrix.at(9, 49) == 3.0);
+        data = matrix.data();
+
+        Matrix<T> moved(std::move(matrix));
+        BOOST_TEST(moved.memoryResource() == &pool);
+        BOOST_TEST(moved.data() == data);
+
+        Matrix<T> copy(moved);
+        BOOST_TEST(copy.memoryResource() == nullptr);
+    }
+    auto reserved = pool.reserved();
+
+    Matrix<T> matrix(&pool);
+    matrix.reshape(50, 10);
+    BOOST_TEST(matrix.data() == data);
+    BOOST_TEST(pool.reserved() == reserved);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,7 +4,9 @@
 #include <boost/mpl/list.hpp>
 #include <boost/test/test_case_template.hpp>
 #include <boost/test/unit_test.hpp>
+#include <cstdint>
 #include <numeric>
+#include <type_traits>
 
 namespace utf = boost::unit_test;
 namespace tt  = boost::test_tools;
@@ -93,6 +95,9 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_copy_constructor, T, test_types, SmallMatr
 
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_move_constructor, T, test_types, SmallMatrix)
 {
+    static_assert(std::is_nothrow_move_constructible_v<Matrix<T>>);
+    static_assert(std::is_nothrow_move_assignable_v<Matrix<T>>);
+
     Matrix<T> matrix1(rows, cols, autoResize, fillVal);
     Matrix<T> matrix2(std::move(matrix1));
     BOOST_TEST(matrix1.size() == 0);
@@ -114,6 +119,65 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_move_constructor, T, test_types, SmallMatr
       std::all_of(matrix2.begin(), matrix2.end(), [this](const T val) { return val == static_cast<T>(fillVal); }));
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_wrapping_constructor, T, test_types, SmallMatrix)
+{
+    std::vector<T> buffer(rows * cols);
+    std::iota(buffer.begin(), buffer.end(), 0);
+    {
+        Matrix<T> matrix(buffer.data(), rows, cols);
+        BOOST_TEST(!matrix.ownsData());
+        BOOST_TEST(matrix.data() == buffer.data());
+        BOOST_TEST(matrix.size() == rows * cols);
+        BOOST_TEST(matrix.numRows() == rows);
+        BOOST_TEST(matrix.at(1, 2) == buffer[cols + 2]);
+
+        matrix.at(0, 0) = fillVal;
+        Matrix<T> copy(matrix);
+        BOOST_TEST(copy.ownsData());
+        BOOST_TEST(copy.data() != buffer.data());
+        BOOST_CHECK_EQUAL_COLLECTIONS(copy.begin(), copy.end(), buffer.begin(), buffer.end());
+
+        Matrix<T> moved(std::move(matrix));
+        BOOST_TEST(!moved.ownsData());
+        BOOST_TEST(moved.data() == buffer.data());
+    }
+    BOOST_TEST(buffer[0] == static_cast<T>(fillVal));
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_strided_wrapping_constructor, T, test_types, SmallMatrix)
+{
+    std::vector<T> buffer(rows * (cols + 2));
+    std::iota(buffer.begin(), buffer.end(), 0);
+
+    Matrix<T> matrix(buffer.data(), rows, cols, cols + 2);
+    BOOST_TEST(!matrix.ownsData());
+    BOOST_TEST(matrix.ld() == cols + 2);
+    BOOST_TEST(matrix.size() == rows * cols);
+    BOOST_TEST(matrix.at(1, 2) == buffer[cols + 4]);
+    BOOST_CHECK_THROW(Matrix<T>(buffer.data(), rows, cols, cols - 1), std::length_error);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_padded_constructor, T, test_types, SmallMatrix)
+{
+    Matrix<T> matrix(rows, cols, autoResize, fillVal, true);
+    auto alignment = Matrix<T>::ALIGNMENT;
+    BOOST_TEST(matrix.ld() == Matrix<T>::paddedCols(cols));
+    BOOST_TEST(matrix.ld() >= cols);
+    BOOST_TEST(matrix.ld() * sizeof(T) % alignment == 0);
+    BOOST_TEST(matrix.size() == rows * cols);
+    BOOST_TEST(matrix.capacity() == rows * cols);
+    BOOST_TEST(matrix.bytes() == rows * matrix.ld() * sizeof(T));
+
+    for (int64_t i = 0; i < rows; ++i)
+    {
+        BOOST_TEST(reinterpret_cast<std::uintptr_t>(matrix.at(i)) % alignment == 0);
+        BOOST_TEST(std::all_of(matrix.crowBegin(i), matrix.crowEnd(i),
+                               [this](const T val) { return val == static_cast<T>(fillVal); }));
+        BOOST_TEST(std::all_of(matrix.at(i) + cols, matrix.at(i) + matrix.ld(),
+                               [](const T val) { return val == static_cast<T>(0); }));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(matrix_operators)
@@ -164,6 +228,86 @@ BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(matrix_functions)
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_reshape, T, test_types, SmallMatrix)
+{
+    Matrix<T> matrix(rows, cols, autoResize, fillVal);
+    auto data = matrix.data();
+
+    matrix.reshape(cols, rows / 2);
+    BOOST_TEST(matrix.data() == data);
+    BOOST_TEST(matrix.rows() == cols);
+    BOOST_TEST(matrix.cols() == rows / 2);
+    BOOST_TEST(matrix.capacity() == cols * (rows / 2));
+    BOOST_TEST(matrix.allocated() == rows * cols);
+    BOOST_TEST(matrix.numRows() == 0);
+    BOOST_TEST(matrix.size() == 0);
+
+    matrix.reshape(rows, cols, true, 3);
+    BOOST_TEST(matrix.data() == data);
+    BOOST_TEST(matrix.size() == rows * cols);
+    BOOST_TEST(std::all_of(matrix.begin(), matrix.end(), [](const T val) { return val == static_cast<T>(3); }));
+
+    matrix.reshape(rows + 1, cols);
+    BOOST_TEST(matrix.capacity() == (rows + 1) * cols);
+    BOOST_TEST(matrix.allocated() == (rows + 1) * cols);
+
+    BOOST_CHECK_THROW(matrix.reshape(-1, cols), std::length_error);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_uninitialized, T, test_types, SmallMatrix)
+{
+    auto matrix = Matrix<T>::uninitialized(rows, cols, true);
+    BOOST_TEST(matrix.size() == rows * cols);
+    BOOST_TEST(matrix.numRows() == rows);
+    BOOST_TEST(matrix.ld() == Matrix<T>::paddedCols(cols));
+
+    auto data = matrix.data();
+    matrix.reshapeUninitialized(rows, cols / 2);
+    BOOST_TEST(matrix.data() == data);
+    BOOST_TEST(matrix.numRows() == rows);
+    BOOST_TEST(matrix.ld() == Matrix<T>::paddedCols(cols / 2));
+
+    matrix.reshapeUninitialized(rows + 1, cols);
+    BOOST_TEST(matrix.data() != nullptr);
+    BOOST_TEST(matrix.allocated() >= (rows + 1) * Matrix<T>::paddedCols(cols));
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_copy_assignment_reuses_allocation, T, test_types, SmallMatrix)
+{
+    Matrix<T> matrix1(rows / 2, cols, autoResize, fillVal);
+    Matrix<T> matrix2(rows, cols);
+    auto data = matrix2.data();
+
+    matrix2 = matrix1;
+    BOOST_TEST(matrix2.data() == data);
+    BOOST_TEST(matrix2.rows() == rows / 2);
+    BOOST_TEST(matrix2.capacity() == matrix1.capacity());
+    BOOST_CHECK_EQUAL_COLLECTIONS(matrix1.begin(), matrix1.end(), matrix2.begin(), matrix2.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_huge_page_policy, T, test_types)
+{
+    Matrix<T> matrix;
+    matrix.setAllocationPolicy(Matrix<T>::AllocationPolicy::HugePages);
+    matrix.reshape(10, 10, true, 1.0);
+    BOOST_TEST(!matrix.mapped());
+
+    const int64_t rows = Matrix<T>::HUGE_PAGE_SIZE / 1000;
+    matrix.reshape(rows, 1000, true, 1.0);
+    BOOST_TEST(matrix.mapped());
+    BOOST_TEST(reinterpret_cast<uintptr_t>(matrix.data()) % Matrix<T>::HUGE_PAGE_SIZE == 0);
+    BOOST_TEST(matrix.at(rows - 1, 999) == 1.0);
+
+    Matrix<T> copy(matrix);
+    BOOST_TEST(copy.mapped());
+    BOOST_TEST(copy == matrix);
+
+    Matrix<T> moved(std::move(matrix));
+    BOOST_TEST(moved.mapped());
+    BOOST_TEST((moved.allocationPolicy() == Matrix<T>::AllocationPolicy::HugePages));
+    BOOST_TEST(!matrix.mapped());
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_container_append, T, test_types, SmallMatrix)
 {
     Matrix<T> matrix(rows, cols);
@@ -319,6 +463,45 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_find, T, test_types, SmallMatrix)
     BOOST_TEST(coords.second == 25);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_padded_rows, T, test_types, SmallMatrix)
+{
+    Matrix<T> packed(rows, cols);
+    Matrix<T> padded(rows, cols, false, 0.0, true);
+    std::vector<T> vec(cols);
+    for (int i = 0; i < rows; ++i)
+    {
+        std::iota(vec.begin(), vec.end(), i * cols);
+        packed.append(vec);
+        padded.append(vec.cbegin(), vec.cend());
+    }
+
+    for (int i = 0; i < rows; ++i)
+    {
+        BOOST_CHECK_EQUAL_COLLECTIONS(padded.crowBegin(i), padded.crowEnd(i), packed.crowBegin(i), packed.crowEnd(i));
+        BOOST_TEST(padded.at(i, 3) == packed.at(i, 3));
+    }
+    BOOST_CHECK_EQUAL_COLLECTIONS(padded.ccolBegin(3), padded.ccolEnd(3), packed.ccolBegin(3), packed.ccolEnd(3));
+
+    auto coords = padded.find(rows * cols - 2);
+    BOOST_TEST(coords.first == rows - 1);
+    BOOST_TEST(coords.second == cols - 2);
+
+    Matrix<T> copy(padded);
+    BOOST_TEST(copy.ld() == padded.ld());
+    BOOST_TEST(copy == padded);
+
+    padded.set(0, vec);
+    BOOST_TEST(copy != padded);
+
+    padded.fill(fillVal);
+    BOOST_TEST(padded.at(rows - 1, cols - 1) == static_cast<T>(fillVal));
+    BOOST_TEST(*(padded.at(0) + cols) == static_cast<T>(0));
+
+    padded.reshape(cols, rows, true, fillVal);
+    BOOST_TEST(padded.ld() == Matrix<T>::paddedCols(rows));
+    BOOST_TEST(*(padded.at(0) + rows) == static_cast<T>(0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(matrix_accessors)
@@ -426,6 +609,33 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_col_iterator, T, test_types, SmallMatrix)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_random_access_col_iterator, T, test_types, SmallMatrix)
+{
+    static_assert(std::is_same<typename std::iterator_traits<typename Matrix<T>::const_col_iterator>::iterator_category,
+                               std::random_access_iterator_tag>::value);
+    static_assert(std::is_same<typename Matrix<T>::const_row_iterator, const T*>::value);
+
+    Matrix<T> matrix(rows, cols, false, 0.0, true);
+    std::vector<T> vec(cols);
+    for (int i = 0; i < rows; ++i)
+    {
+        std::iota(vec.begin(), vec.end(), i * cols);
+        matrix.append(vec);
+    }
+
+    typename Matrix<T>::const_col_iterator iter = matrix.colBegin(2);
+    BOOST_TEST((matrix.ccolEnd(2) - iter) == rows);
+    BOOST_TEST(iter[3] == matrix.at(3, 2));
+    BOOST_TEST(*(iter + 4) == matrix.at(4, 2));
+    BOOST_TEST(*(matrix.ccolEnd(2) - 1) == matrix.at(rows - 1, 2));
+    BOOST_TEST(*iter++ == matrix.at(0, 2));
+    BOOST_TEST(*iter == matrix.at(1, 2));
+    BOOST_TEST(*++iter == matrix.at(2, 2));
+    BOOST_TEST(*--iter == matrix.at(1, 2));
+    BOOST_TEST((iter < matrix.ccolEnd(2)));
+    BOOST_TEST(*std::max_element(matrix.ccolBegin(2), matrix.ccolEnd(2)) == matrix.at(rows - 1, 2));
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_const_col_iterator, T, test_types, SmallMatrix)
 {
     std::array<Matrix<T>, 2> matrices = { Matrix<T>(1, cols), Matrix<T>(6, cols) };
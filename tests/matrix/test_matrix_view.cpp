@@ -0,0 +1,91 @@
+#include <matrix/matrix.hpp>
+#include <matrix/matrix_view.hpp>
+#define BOOST_TEST_MODULE test_matrix_view
+#include <boost/mpl/list.hpp>
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+typedef boost::mpl::list<float, double> test_types;
+
+struct ViewFixture
+{
+    ViewFixture() : rows(10), cols(7), buffer(rows * cols) { std::iota(buffer.begin(), buffer.end(), 0); }
+
+    ~ViewFixture() {}
+
+    int64_t rows;
+    int64_t cols;
+    std::vector<double> buffer;
+};
+
+BOOST_AUTO_TEST_SUITE(matrix_view)
+
+BOOST_FIXTURE_TEST_CASE(test_buffer_view, ViewFixture)
+{
+    MatrixView<double> view(buffer.data(), rows, cols);
+    BOOST_TEST(view.rows() == rows);
+    BOOST_TEST(view.numRows() == rows);
+    BOOST_TEST(view.cols() == cols);
+    BOOST_TEST(view.ld() == cols);
+    BOOST_TEST(view.data() == buffer.data());
+    BOOST_TEST(view.at(3, 4) == 3 * cols + 4);
+    BOOST_CHECK_EQUAL_COLLECTIONS(view.crowBegin(2), view.crowEnd(2), buffer.begin() + 2 * cols,
+                                  buffer.begin() + 3 * cols);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_row_range, ViewFixture)
+{
+    auto view = MatrixView<double>(buffer.data(), rows, cols).rowRange(4, 3);
+    BOOST_TEST(view.rows() == 3);
+    BOOST_TEST(view.cols() == cols);
+    BOOST_TEST(view.at(0, 0) == 4 * cols);
+    BOOST_TEST(view.at(2, cols - 1) == 7 * cols - 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_col_range, ViewFixture)
+{
+    auto view = MatrixView<double>(buffer.data(), rows, cols).colRange(2, 3);
+    BOOST_TEST(view.rows() == rows);
+    BOOST_TEST(view.cols() == 3);
+    BOOST_TEST(view.ld() == cols);
+    for (int64_t i = 0; i < rows; ++i)
+    {
+        BOOST_TEST(view.crowEnd(i) - view.crowBegin(i) == 3);
+        BOOST_TEST(*view.crowBegin(i) == i * cols + 2);
+    }
+
+    BOOST_TEST((view.ccolEnd(1) - view.ccolBegin(1)) == rows);
+    BOOST_TEST(view.ccolBegin(1)[5] == 5 * cols + 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_range_fail, ViewFixture)
+{
+    MatrixView<double> view(buffer.data(), rows, cols);
+    BOOST_CHECK_THROW(view.rowRange(8, 3), std::out_of_range);
+    BOOST_CHECK_THROW(view.colRange(-1, 2), std::out_of_range);
+    BOOST_CHECK_THROW(MatrixView<double>(buffer.data(), rows, cols, cols - 1), std::length_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_from_matrix, T, test_types)
+{
+    Matrix<T> matrix(6, 5, false, 0.0, true);
+    for (int i = 0; i < 4; ++i)
+    {
+        std::vector<T> row(5, i);
+        matrix.append(row);
+    }
+
+    MatrixView<T> view = matrix;
+    BOOST_TEST(view.rows() == matrix.numRows());
+    BOOST_TEST(view.cols() == matrix.cols());
+    BOOST_TEST(view.ld() == matrix.ld());
+    for (int i = 0; i < 4; ++i)
+    {
+        BOOST_CHECK_EQUAL_COLLECTIONS(view.crowBegin(i), view.crowEnd(i), matrix.crowBegin(i), matrix.crowEnd(i));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()